@@ -100,6 +100,7 @@
 #include <86box/midi.h>
 #include <86box/snd_speaker.h>
 #include <86box/video.h>
+#include <86box/capture.h>
 #include <86box/ui.h>
 #include <86box/path.h>
 #include <86box/plat.h>
@@ -110,6 +111,7 @@
 #include <86box/acpi.h>
 #include <86box/nv/vid_nv_rivatimer.h>
 #include <86box/vfio.h>
+#include <86box/pace.h>
 
 // Disable c99-designator to avoid the warnings about int ng
 #ifdef __clang__
@@ -179,6 +181,11 @@ int      force_43                               = 0;              /* (C) video *
 int      video_filter_method                    = 1;              /* (C) video */
 int      video_vsync                            = 0;              /* (C) video */
 int      video_framerate                        = -1;             /* (C) video */
+int      video_frameskip                        = 0;              /* (C) video */
+int      video_render_thread                    = 0;              /* (C) video */
+int      screenshot_format                      = 0;              /* (C) video */
+int      screenshot_compression                 = -1;             /* (C) video */
+int      capture_enabled                        = 0;              /* (C) record audio and video */
 bool     serial_passthrough_enabled[SERIAL_MAX - 1] = { 0, 0, 0, 0, 0, 0, 0 }; /* (C) activation and kind of
                                                                                   pass-through for serial ports */
 int      bugger_enabled                         = 0;              /* (C) enable ISAbugger */
@@ -224,6 +231,11 @@ int      sound_muted                            = 0;              /* (C) Is soun
 int      jumpered_internal_ecp_dma              = 0;              /* (C) Jumpered internal EPC DMA */
 int      inhibit_multimedia_keys;                                 /* (G) Inhibit multimedia keys on Windows. */
 int      force_10ms;                                              /* (C) Force 10ms CPU frame intervals. */
+int      speed_mult                             = 1;              /* (C) Guest speed multiplier, 1 = real time. */
+char     thread_affinity[THREAD_ROLE_MAX][128]  = { { '\0' } };   /* (C) Host CPUs for each thread role. */
+int      emu_thread_priority                    = 0;              /* (C) Emulation thread priority: 0 = normal,
+                                                                     1 = raised, 2 = real time; on Linux
+                                                                     this needs CAP_SYS_NICE. */
 int      vmm_disabled                           = 0;              /* (G) disable built-in manager */
 char     vmm_path_cfg[1024]                     = { '\0' };       /* (G) VMs path (unless -E is used)*/
 
@@ -319,6 +331,11 @@ struct accelKey def_acc_keys[NUM_ACCELS] = {
         .name="force_interpretation",
         .desc="Force interpretation",
         .seq="Ctrl+Alt+I"
+    },
+    {
+        .name="cycle_speed",
+        .desc="Cycle speed multiplier",
+        .seq=""
     }
 };
 
@@ -364,6 +381,12 @@ __thread int is_cpu_thread = 0;
 
 static wchar_t mouse_msg[3][200];
 
+const char *thread_role_names[THREAD_ROLE_MAX] = { "emu", "blit", "voodoo", "sound" };
+
+/* Thread settings given on the command line, these override the config. */
+static char thread_affinity_cmdline[THREAD_ROLE_MAX][128];
+static int  emu_thread_priority_cmdline = -1;
+
 static ATOMIC_INT do_pause_ack = 0;
 static ATOMIC_INT pause_ack = 0;
 
@@ -712,11 +735,15 @@ pc_show_usage(void)
 #ifdef USE_INSTRUMENT
             "-J or --instrument name\t- set 'name' to be the profiling instrument\n"
 #endif
+            "-K or --affinity role=cpus\t- run the 'role' thread(s) (emu, blit, voodoo\n"
+            "\t\t\t\t   or sound) on host CPUs 'cpus' (e.g. 2 or 0-3,6)\n"
             "-L or --logfile path\t\t- set 'path' to be the logfile\n"
             "-M or --missing\t\t- dump missing machines and video cards\n"
             "-N or --noconfirm\t\t- do not ask for confirmation on quit\n"
             "-P or --vmpath path\t\t- set 'path' to be root for vm\n"
             "-O or --global path\t\t- set 'path' to be global config file\n"
+            "-Q or --priority level\t\t- emulation thread priority (0 = normal,\n"
+            "\t\t\t\t   1 = raised, 2 = real time)\n"
             "-R or --rompath path\t\t- set 'path' to be ROM path\n"
 #ifndef USE_SDL_UI
             "-S or --settings\t\t\t- show only the settings dialog\n"
@@ -769,6 +796,7 @@ pc_init(int argc, char *argv[])
     const struct tm *info;
     time_t           now;
     int              c;
+    int              i;
     int              lvmp = 0;
 #ifdef ENABLE_NG
     int ng = 0;
@@ -921,6 +949,30 @@ usage:
             pclog("Drive %c: %s\n", drive + 0x41, fn[(int) drive]);
             free(temp2);
             temp2 = NULL;
+        } else if (!strcasecmp(argv[c], "--affinity") || !strcasecmp(argv[c], "-K")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            what = argv[++c];
+            p    = strchr(what, '=');
+            if (p == NULL)
+                goto usage;
+
+            for (i = 0; i < THREAD_ROLE_MAX; i++) {
+                if (((p - what) == (int) strlen(thread_role_names[i])) && !strncasecmp(what, thread_role_names[i], p - what))
+                    break;
+            }
+            if (i == THREAD_ROLE_MAX)
+                goto usage;
+
+            snprintf(thread_affinity_cmdline[i], sizeof(thread_affinity_cmdline[i]), "%s", p + 1);
+        } else if (!strcasecmp(argv[c], "--priority") || !strcasecmp(argv[c], "-Q")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            emu_thread_priority_cmdline = atoi(argv[++c]);
+            if ((emu_thread_priority_cmdline < 0) || (emu_thread_priority_cmdline > 2))
+                goto usage;
         } else if (!strcasecmp(argv[c], "--vmname") || !strcasecmp(argv[c], "-V")) {
             if ((c + 1) == argc)
                 goto usage;
@@ -1624,6 +1676,8 @@ pc_reset_hard_close(void)
 {
     ui_sb_set_ready(0);
 
+    capture_stop();
+
     /* Close all the memory mappings. */
     mem_close();
 
@@ -1839,6 +1893,9 @@ pc_reset_hard_init(void)
     if (test_mode)
         pc_test_mode_entry_point();
 
+    if (capture_enabled)
+        capture_start();
+
     ui_hard_reset_completed();
 }
 
@@ -1907,6 +1964,90 @@ pc_reset_hard(void)
     hard_reset_pending = 1;
 }
 
+/* Parses a host CPU list such as "2" or "0-3,6" into a mask. */
+static uint64_t
+pc_parse_cpu_list(const char *list)
+{
+    uint64_t    mask = 0;
+    const char *p    = list;
+    char       *end;
+    long        first;
+    long        last;
+
+    while (*p != '\0') {
+        first = strtol(p, &end, 10);
+        if (end == p)
+            break;
+
+        last = first;
+        if (*end == '-') {
+            p    = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p)
+                break;
+        }
+
+        for (long i = first; (i <= last) && (i < 64); i++) {
+            if (i >= 0)
+                mask |= (1ULL << i);
+        }
+
+        p = end;
+        if (*p == ',')
+            p++;
+    }
+
+    return mask;
+}
+
+/* Applies the configured host CPU affinity and, for the emulation thread,
+   the scheduling priority to the calling thread. */
+void
+pc_thread_setup(int role)
+{
+    const char *list = thread_affinity_cmdline[role][0] ? thread_affinity_cmdline[role] : thread_affinity[role];
+    uint64_t    mask = pc_parse_cpu_list(list);
+    int         prio;
+
+    if (mask)
+        plat_set_thread_affinity(mask);
+
+    if (role == THREAD_ROLE_EMU) {
+        prio = (emu_thread_priority_cmdline >= 0) ? emu_thread_priority_cmdline : emu_thread_priority;
+        if (prio)
+            plat_set_thread_priority(prio);
+    }
+}
+
+/* Step the guest speed multiplier through 1x, 2x, 4x and 8x. */
+void
+pc_cycle_speed(void)
+{
+    speed_mult <<= 1;
+    if (speed_mult > SPEED_MULT_MAX)
+        speed_mult = 1;
+}
+
+#ifdef ENABLE_PC_LOG
+/* Logs how late the emulation thread picked up its periods, see pace.c. */
+static void
+pc_log_pacing(void)
+{
+    static const char *names[PACE_LATE_BUCKETS] = {
+        "< 0.1", "< 0.25", "< 0.5", "< 1", "< 2", "< 5", "< 10", ">= 10"
+    };
+    uint64_t late[PACE_LATE_BUCKETS];
+    uint64_t dropped;
+
+    pace_get_lateness(late, &dropped);
+
+    pc_log("Pacing lateness:\n");
+    for (int i = 0; i < PACE_LATE_BUCKETS; i++)
+        pc_log("  %6s ms: %" PRIu64 "\n", names[i], late[i]);
+    pc_log("  gave up catching up %" PRIu64 " times\n", dropped);
+}
+#endif
+
 void
 pc_close(UNUSED(thread_t *ptr))
 {
@@ -1941,6 +2082,12 @@ pc_close(UNUSED(thread_t *ptr))
         dumpregs(0);
 #endif
 
+#ifdef ENABLE_PC_LOG
+    pc_log_pacing();
+#endif
+
+    capture_stop();
+
     video_close();
 
     device_close_all();
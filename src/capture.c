@@ -0,0 +1,421 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Audio and video recorder.
+ *
+ *          Every buffer mixed by sound_poll() is recorded together with
+ *          the frame monitor 0 published last, so the video runs at the
+ *          sound buffer rate and stays in step with the audio by
+ *          construction. The audio goes to a 16-bit stereo WAV file and
+ *          the video to an uncompressed 4:4:4 YUV4MPEG2 file. Whenever
+ *          the frame size changes, both files are closed and a new
+ *          numbered pair is started at the new size.
+ *
+ *          The emulation thread only copies into a bounded ring; the
+ *          colour conversion and all file writes are done by the
+ *          recorder thread. If the disk falls behind far enough to
+ *          fill the ring, the emulation thread waits for it.
+ *
+ * Authors: agent, <agent@local>
+ *
+ *          Copyright 2025 agent.
+ */
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include <86box/path.h>
+#include <86box/plat.h>
+#include <86box/thread.h>
+#include <86box/video.h>
+#include <86box/sound.h>
+#include <86box/capture.h>
+
+/* 16 sound buffers, or 320 ms. */
+#define CAPTURE_RING_SIZE 16
+
+typedef struct capture_slot_t {
+    int16_t   audio[SOUNDBUFLEN * 2];
+    int       audio_len;
+    /* Pixels of a new frame, or the previous frame again if not set. */
+    uint32_t *pixels;
+    size_t    pixels_size;
+    int       new_frame;
+    /* Frame size of the segment this slot belongs to. */
+    int       w;
+    int       h;
+} capture_slot_t;
+
+static capture_slot_t capture_ring[CAPTURE_RING_SIZE];
+static int            capture_head;
+static int            capture_tail;
+static int            capture_count;
+static volatile int   capture_run;
+static int            capture_on;
+static thread_t      *capture_thread;
+static mutex_t       *capture_mutex;
+static event_t       *capture_wake;
+static event_t       *capture_space;
+
+/* Size of the last frame queued, 0 until the first one. */
+static int      capture_w;
+static int      capture_h;
+static uint32_t capture_seq;
+
+/* Recorder thread state. */
+static char     capture_base[1024];
+static int      capture_segment;
+static int      capture_out_w;
+static int      capture_out_h;
+static FILE    *capture_y4m;
+static FILE    *capture_wav;
+static uint8_t *capture_yuv;
+static uint32_t capture_wav_bytes;
+
+#ifdef ENABLE_CAPTURE_LOG
+int capture_do_log = ENABLE_CAPTURE_LOG;
+
+static void
+capture_log(const char *fmt, ...)
+{
+    va_list ap;
+
+    if (capture_do_log) {
+        va_start(ap, fmt);
+        pclog_ex(fmt, ap);
+        va_end(ap);
+    }
+}
+#else
+#    define capture_log(fmt, ...)
+#endif
+
+static void
+capture_put_le(uint8_t *p, uint32_t val, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        p[i] = (val >> (i << 3)) & 0xff;
+}
+
+static void
+capture_wav_header(FILE *fp, uint32_t data_bytes)
+{
+    uint8_t hdr[44];
+
+    memcpy(&hdr[0], "RIFF", 4);
+    capture_put_le(&hdr[4], 36 + data_bytes, 4);
+    memcpy(&hdr[8], "WAVEfmt ", 8);
+    capture_put_le(&hdr[16], 16, 4);              /* fmt chunk size */
+    capture_put_le(&hdr[20], 1, 2);               /* PCM */
+    capture_put_le(&hdr[22], 2, 2);               /* channels */
+    capture_put_le(&hdr[24], SOUND_FREQ, 4);      /* sample rate */
+    capture_put_le(&hdr[28], SOUND_FREQ * 4, 4);  /* byte rate */
+    capture_put_le(&hdr[32], 4, 2);               /* block align */
+    capture_put_le(&hdr[34], 16, 2);              /* bits per sample */
+    memcpy(&hdr[36], "data", 4);
+    capture_put_le(&hdr[40], data_bytes, 4);
+
+    fwrite(hdr, 1, sizeof(hdr), fp);
+}
+
+/* Starts the next numbered segment, with frames of w by h pixels. */
+static void
+capture_open_files(int w, int h)
+{
+    char path[1024];
+    int  plane = w * h;
+
+    capture_out_w = w;
+    capture_out_h = h;
+    capture_segment++;
+
+    snprintf(path, sizeof(path), "%s-%03d.y4m", capture_base, capture_segment);
+    capture_y4m = plat_fopen(path, "wb");
+    if (capture_y4m != NULL)
+        fprintf(capture_y4m, "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C444\n",
+                w, h, SOUND_FREQ, SOUNDBUFLEN);
+    else
+        capture_log("CAPTURE: unable to open %s\n", path);
+
+    snprintf(path, sizeof(path), "%s-%03d.wav", capture_base, capture_segment);
+    capture_wav = plat_fopen(path, "wb");
+    if (capture_wav != NULL)
+        capture_wav_header(capture_wav, 0);
+    else
+        capture_log("CAPTURE: unable to open %s\n", path);
+    capture_wav_bytes = 0;
+
+    /* Black, for as long as no frame has been converted. */
+    capture_yuv = (uint8_t *) malloc(plane * 3);
+    memset(capture_yuv, 16, plane);
+    memset(&capture_yuv[plane], 128, plane * 2);
+}
+
+static void
+capture_close_files(void)
+{
+    if (capture_wav != NULL) {
+        fseek(capture_wav, 0, SEEK_SET);
+        capture_wav_header(capture_wav, capture_wav_bytes);
+        fclose(capture_wav);
+        capture_wav = NULL;
+    }
+
+    if (capture_y4m != NULL) {
+        fclose(capture_y4m);
+        capture_y4m = NULL;
+    }
+
+    free(capture_yuv);
+    capture_yuv = NULL;
+}
+
+/* BT.601, studio range. */
+static void
+capture_convert(const uint32_t *pixels)
+{
+    const int plane = capture_out_w * capture_out_h;
+    uint8_t  *yp    = capture_yuv;
+    uint8_t  *up    = &capture_yuv[plane];
+    uint8_t  *vp    = &capture_yuv[plane * 2];
+
+    for (int i = 0; i < plane; i++) {
+        const int r = (pixels[i] >> 16) & 0xff;
+        const int g = (pixels[i] >> 8) & 0xff;
+        const int b = pixels[i] & 0xff;
+
+        yp[i] = (uint8_t) (((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        up[i] = (uint8_t) (((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        vp[i] = (uint8_t) (((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+}
+
+static void
+capture_write(const capture_slot_t *slot)
+{
+    if ((capture_yuv != NULL) && ((slot->w != capture_out_w) || (slot->h != capture_out_h)))
+        capture_close_files();
+    if (capture_yuv == NULL)
+        capture_open_files(slot->w, slot->h);
+
+    if (capture_y4m != NULL) {
+        if (slot->new_frame)
+            capture_convert(slot->pixels);
+        fputs("FRAME\n", capture_y4m);
+        fwrite(capture_yuv, 1, (size_t) capture_out_w * capture_out_h * 3, capture_y4m);
+    }
+
+    if (capture_wav != NULL) {
+        uint8_t buf[SOUNDBUFLEN * 2 * 2];
+
+        for (int i = 0; i < slot->audio_len; i++)
+            capture_put_le(&buf[i << 1], (uint16_t) slot->audio[i], 2);
+        fwrite(buf, 2, slot->audio_len, capture_wav);
+        capture_wav_bytes += slot->audio_len * 2;
+    }
+}
+
+static void
+capture_thread_func(UNUSED(void *param))
+{
+    capture_slot_t *slot;
+
+    while (1) {
+        thread_wait_mutex(capture_mutex);
+        if (capture_count == 0) {
+            if (!capture_run) {
+                thread_release_mutex(capture_mutex);
+                break;
+            }
+            thread_reset_event(capture_wake);
+            thread_release_mutex(capture_mutex);
+            thread_wait_event(capture_wake, -1);
+            continue;
+        }
+        slot = &capture_ring[capture_tail];
+        thread_release_mutex(capture_mutex);
+
+        capture_write(slot);
+
+        thread_wait_mutex(capture_mutex);
+        capture_tail = (capture_tail + 1) % CAPTURE_RING_SIZE;
+        capture_count--;
+        thread_set_event(capture_space);
+        thread_release_mutex(capture_mutex);
+    }
+
+    capture_close_files();
+}
+
+/* Copies the visible part of the frame into the slot, growing its buffer
+   if needed. The slot is not in use by the recorder thread. */
+static int
+capture_copy_frame(capture_slot_t *slot, const bitmap_t *bitmap, int x, int y, int w, int h)
+{
+    const size_t size = (size_t) w * h;
+
+    if (slot->pixels_size < size) {
+        uint32_t *pixels = (uint32_t *) realloc(slot->pixels, size * sizeof(uint32_t));
+
+        if (pixels == NULL)
+            return 0;
+        slot->pixels      = pixels;
+        slot->pixels_size = size;
+    }
+
+    for (int row = 0; row < h; row++)
+        memcpy(&slot->pixels[row * w], &bitmap->line[y + row][x], w * sizeof(uint32_t));
+
+    return 1;
+}
+
+/* Called by sound_poll() with every mixed buffer; runs on the emulation
+   thread. */
+void
+capture_poll(const int32_t *buf, int len)
+{
+    const bitmap_t *bitmap;
+    capture_slot_t *slot;
+    int             x;
+    int             y;
+    int             w;
+    int             h;
+    uint32_t        seq = 0;
+
+    if (!capture_on)
+        return;
+
+    bitmap = video_last_frame_monitor(0, &x, &y, &w, &h, &seq);
+
+    if ((bitmap != NULL) && ((w <= 0) || (h <= 0)))
+        bitmap = NULL;
+
+    /* The recording starts with the first frame. */
+    if (capture_w == 0) {
+        if (bitmap == NULL)
+            return;
+
+        capture_seq = seq - 1;
+    }
+
+    thread_wait_mutex(capture_mutex);
+    while (capture_count == CAPTURE_RING_SIZE) {
+        thread_reset_event(capture_space);
+        thread_release_mutex(capture_mutex);
+        thread_wait_event(capture_space, -1);
+        thread_wait_mutex(capture_mutex);
+    }
+    slot = &capture_ring[capture_head];
+    thread_release_mutex(capture_mutex);
+
+    if (len > SOUNDBUFLEN)
+        len = SOUNDBUFLEN;
+    for (int i = 0; i < (len << 1); i++) {
+        if (buf[i] > 32767)
+            slot->audio[i] = 32767;
+        else if (buf[i] < -32768)
+            slot->audio[i] = -32768;
+        else
+            slot->audio[i] = (int16_t) buf[i];
+    }
+    slot->audio_len = len << 1;
+
+    slot->new_frame = (bitmap != NULL) && (seq != capture_seq) &&
+                      capture_copy_frame(slot, bitmap, x, y, w, h);
+    if (slot->new_frame) {
+        /* A new size makes the recorder thread start a new segment. */
+        capture_w   = w;
+        capture_h   = h;
+        capture_seq = seq;
+    }
+    if (capture_w == 0)
+        return;
+    slot->w = capture_w;
+    slot->h = capture_h;
+
+    thread_wait_mutex(capture_mutex);
+    capture_head = (capture_head + 1) % CAPTURE_RING_SIZE;
+    capture_count++;
+    thread_set_event(capture_wake);
+    thread_release_mutex(capture_mutex);
+}
+
+int
+capture_active(void)
+{
+    return capture_on;
+}
+
+void
+capture_start(void)
+{
+    char fn[256];
+
+    if (capture_on)
+        return;
+
+    path_append_filename(capture_base, usr_path, CAPTURE_PATH);
+    if (!plat_dir_check(capture_base))
+        plat_dir_create(capture_base);
+    path_slash(capture_base);
+
+    memset(fn, 0, sizeof(fn));
+    plat_tempfile(fn, "Capture", "");
+    strcat(capture_base, fn);
+
+    capture_log("CAPTURE: recording to %s\n", capture_base);
+
+    capture_w       = 0;
+    capture_h       = 0;
+    capture_segment = 0;
+    capture_out_w   = 0;
+    capture_out_h   = 0;
+    capture_head    = 0;
+    capture_tail    = 0;
+    capture_count   = 0;
+    capture_mutex   = thread_create_mutex();
+    capture_wake    = thread_create_event();
+    capture_space   = thread_create_event();
+    capture_run     = 1;
+    capture_thread  = thread_create(capture_thread_func, NULL);
+    capture_on      = 1;
+}
+
+/* Stops the recording once everything queued has been written. The
+   emulation thread must not be in capture_poll(). */
+void
+capture_stop(void)
+{
+    if (!capture_on)
+        return;
+
+    capture_on = 0;
+
+    thread_wait_mutex(capture_mutex);
+    capture_run = 0;
+    thread_set_event(capture_wake);
+    thread_release_mutex(capture_mutex);
+    thread_wait(capture_thread);
+    capture_thread = NULL;
+
+    thread_destroy_event(capture_space);
+    thread_destroy_event(capture_wake);
+    thread_close_mutex(capture_mutex);
+
+    for (int i = 0; i < CAPTURE_RING_SIZE; i++) {
+        free(capture_ring[i].pixels);
+        capture_ring[i].pixels      = NULL;
+        capture_ring[i].pixels_size = 0;
+    }
+
+    capture_log("CAPTURE: stopped\n");
+}
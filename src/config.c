@@ -209,12 +209,33 @@ load_general(void)
     dpi_scale = ini_section_get_int(cat, "dpi_scale", 1);
 
     enable_overscan  = !!ini_section_get_int(cat, "enable_overscan", 0);
+    video_frameskip  = !!ini_section_get_int(cat, "video_frameskip", 0);
+    video_render_thread = !!ini_section_get_int(cat, "video_render_thread", 0);
+    screenshot_format      = ini_section_get_int(cat, "screenshot_format", SCREENSHOT_FORMAT_PNG);
+    screenshot_compression = ini_section_get_int(cat, "screenshot_compression", -1);
+    capture_enabled        = !!ini_section_get_int(cat, "capture_enabled", 0);
     vid_cga_contrast = !!ini_section_get_int(cat, "vid_cga_contrast", 0);
     video_grayscale  = ini_section_get_int(cat, "video_grayscale", 0);
     video_graytype   = ini_section_get_int(cat, "video_graytype", 0);
 
     force_10ms = !!ini_section_get_int(cat, "force_10ms", 0);
 
+    speed_mult = ini_section_get_int(cat, "speed_multiplier", 1);
+    if (speed_mult < 1)
+        speed_mult = 1;
+    else if (speed_mult > SPEED_MULT_MAX)
+        speed_mult = SPEED_MULT_MAX;
+
+    for (int i = 0; i < THREAD_ROLE_MAX; i++) {
+        sprintf(temp, "affinity_%s", thread_role_names[i]);
+        p = ini_section_get_string(cat, temp, "");
+        snprintf(thread_affinity[i], sizeof(thread_affinity[i]), "%s", p);
+    }
+
+    emu_thread_priority = ini_section_get_int(cat, "emu_thread_priority", 0);
+    if ((emu_thread_priority < 0) || (emu_thread_priority > 2))
+        emu_thread_priority = 0;
+
     rctrl_is_lalt = ini_section_get_int(cat, "rctrl_is_lalt", 0);
     update_icons  = ini_section_get_int(cat, "update_icons", 1);
 
@@ -2472,6 +2493,22 @@ save_general(void)
     if (force_10ms == 0)
         ini_section_delete_var(cat, "force_10ms");
 
+    ini_section_set_int(cat, "speed_multiplier", speed_mult);
+    if (speed_mult == 1)
+        ini_section_delete_var(cat, "speed_multiplier");
+
+    for (int i = 0; i < THREAD_ROLE_MAX; i++) {
+        sprintf(temp, "affinity_%s", thread_role_names[i]);
+        if (thread_affinity[i][0] != '\0')
+            ini_section_set_string(cat, temp, thread_affinity[i]);
+        else
+            ini_section_delete_var(cat, temp);
+    }
+
+    ini_section_set_int(cat, "emu_thread_priority", emu_thread_priority);
+    if (emu_thread_priority == 0)
+        ini_section_delete_var(cat, "emu_thread_priority");
+
     ini_section_set_int(cat, "sound_muted", sound_muted);
     if (sound_muted == 0)
         ini_section_delete_var(cat, "sound_muted");
@@ -2516,6 +2553,31 @@ save_general(void)
     else
         ini_section_set_int(cat, "enable_overscan", enable_overscan);
 
+    if (video_frameskip == 0)
+        ini_section_delete_var(cat, "video_frameskip");
+    else
+        ini_section_set_int(cat, "video_frameskip", video_frameskip);
+
+    if (video_render_thread == 0)
+        ini_section_delete_var(cat, "video_render_thread");
+    else
+        ini_section_set_int(cat, "video_render_thread", video_render_thread);
+
+    if (screenshot_format == SCREENSHOT_FORMAT_PNG)
+        ini_section_delete_var(cat, "screenshot_format");
+    else
+        ini_section_set_int(cat, "screenshot_format", screenshot_format);
+
+    if (screenshot_compression == -1)
+        ini_section_delete_var(cat, "screenshot_compression");
+    else
+        ini_section_set_int(cat, "screenshot_compression", screenshot_compression);
+
+    if (capture_enabled == 0)
+        ini_section_delete_var(cat, "capture_enabled");
+    else
+        ini_section_set_int(cat, "capture_enabled", capture_enabled);
+
     if (vid_cga_contrast == 0)
         ini_section_delete_var(cat, "vid_cga_contrast");
     else
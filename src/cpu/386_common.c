@@ -17,6 +17,7 @@
 #include "x87_sf.h"
 #include "x87.h"
 #include <86box/nmi.h>
+#include <86box/io.h>
 #include <86box/mem.h>
 #include <86box/smram.h>
 #include <86box/pic.h>
@@ -1776,6 +1777,190 @@ checkio(uint32_t port, int mask)
     return mask;
 }
 
+/* Limit a forward string run at offset off to one page, the offset size and the segment limit. */
+static uint32_t
+rep_block_len(uint32_t addr, uint32_t off, uint32_t cnt, int width, int addr_size, uint32_t limit)
+{
+    uint64_t n   = (0x1000 - (addr & 0xfff)) / width;
+    uint64_t max = (((addr_size == 2) ? 0xffffULL : 0xffffffffULL) - off + 1) / width;
+
+    if (n > max)
+        n = max;
+    max = ((uint64_t) limit - off + 1) / width;
+    if (n > max)
+        n = max;
+    if (n > cnt)
+        n = cnt;
+
+    return (uint32_t) n;
+}
+
+/*
+ * Hand the part of a forward REP INS that lands in the current RAM page
+ * straight to the port's block handler, if it has one. Returns the number of
+ * elements transferred, 0 to fall back to one element per iteration.
+ */
+uint32_t
+rep_ins_block(uint32_t dest, uint32_t cnt, int width, int addr_size)
+{
+    uint32_t  addr   = es + dest;
+    uintptr_t lookup = writelookup2[addr >> 12];
+    uint32_t  n;
+
+    if ((cpu_state.flags & D_FLAG) || (es == 0xffffffff) || (lookup == (uintptr_t) LOOKUP_INV) || (addr & (width - 1)))
+        return 0;
+#ifdef USE_DEBUG_REGS_486
+    if (dr[7] & 0xff)
+        return 0;
+#endif
+
+    n = rep_block_len(addr, dest, cnt, width, addr_size, cpu_state.seg_es.limit_high);
+    if (n < 2)
+        return 0;
+
+    return io_read_block(DX, (void *) (lookup + addr), width, n);
+}
+
+/* Same for REP OUTS, reading from the source segment. */
+uint32_t
+rep_outs_block(x86seg *seg, uint32_t src, uint32_t cnt, int width, int addr_size)
+{
+    uint32_t  addr   = seg->base + src;
+    uintptr_t lookup = readlookup2[addr >> 12];
+    uint32_t  n;
+
+    if ((cpu_state.flags & D_FLAG) || (seg->base == 0xffffffff) || (lookup == (uintptr_t) LOOKUP_INV) || (addr & (width - 1)))
+        return 0;
+#ifdef USE_DEBUG_REGS_486
+    if (dr[7] & 0xff)
+        return 0;
+#endif
+
+    n = rep_block_len(addr, src, cnt, width, addr_size, seg->limit_high);
+    if (n < 2)
+        return 0;
+
+    return io_write_block(DX, (const void *) (lookup + addr), width, n);
+}
+
+/*
+ * Physical address of a linear address the per-element path has just
+ * accessed in the same page, so the page walk has already been done and the
+ * accessed and dirty bits are set. Returns 0xffffffff if it does not map.
+ */
+static uint32_t
+rep_block_phys(uint32_t addr, int width, int rw)
+{
+    uint64_t a = addr;
+
+    if (((addr - width) >> 12) != (addr >> 12))
+        return 0xffffffff;
+
+    if (cr0 >> 31) {
+        a = mmutranslate_noabrt(addr, rw);
+        if (a > 0xffffffffULL)
+            return 0xffffffff;
+    }
+
+    return ((uint32_t) a) & rammask;
+}
+
+/*
+ * Continue a forward REP MOVS between a directly mapped RAM page and a device
+ * page whose memory mapping has a block handler. Returns the number of
+ * elements moved, at most max, 0 to carry on one element at a time.
+ */
+uint32_t
+rep_movs_block(x86seg *seg, uint32_t src, uint32_t dest, uint32_t cnt, int width, int addr_size, uint32_t max)
+{
+    uint32_t             src_addr    = seg->base + src;
+    uint32_t             dest_addr   = es + dest;
+    uintptr_t            src_lookup  = readlookup2[src_addr >> 12];
+    uintptr_t            dest_lookup = writelookup2[dest_addr >> 12];
+    const mem_mapping_t *map;
+    uint32_t             phys;
+    uint32_t             n;
+
+    if ((cpu_state.flags & D_FLAG) || (seg->base == 0xffffffff) || (es == 0xffffffff))
+        return 0;
+#ifdef USE_DEBUG_REGS_486
+    if (dr[7] & 0xff)
+        return 0;
+#endif
+
+    n = rep_block_len(src_addr, src, cnt, width, addr_size, seg->limit_high);
+    n = MIN(n, rep_block_len(dest_addr, dest, cnt, width, addr_size, cpu_state.seg_es.limit_high));
+    n = MIN(n, max);
+    if (n == 0)
+        return 0;
+
+    if ((src_lookup != (uintptr_t) LOOKUP_INV) && (dest_lookup == (uintptr_t) LOOKUP_INV)) {
+        phys = rep_block_phys(dest_addr, width, 1);
+        if (phys == 0xffffffff)
+            return 0;
+        map = write_mapping[phys >> MEM_GRANULARITY_BITS];
+        if ((map == NULL) || (map->write_block == NULL))
+            return 0;
+        return map->write_block(phys, (const void *) (src_lookup + src_addr), width, n, map->priv);
+    } else if ((src_lookup == (uintptr_t) LOOKUP_INV) && (dest_lookup != (uintptr_t) LOOKUP_INV)) {
+        phys = rep_block_phys(src_addr, width, 0);
+        if (phys == 0xffffffff)
+            return 0;
+        map = read_mapping[phys >> MEM_GRANULARITY_BITS];
+        if ((map == NULL) || (map->read_block == NULL))
+            return 0;
+        return map->read_block(phys, (void *) (dest_lookup + dest_addr), width, n, map->priv);
+    }
+
+    return 0;
+}
+
+/* Same for REP STOS into a device page. */
+uint32_t
+rep_stos_block(uint32_t dest, uint32_t cnt, int width, int addr_size, uint32_t max, uint32_t val)
+{
+    uint32_t             dest_addr = es + dest;
+    const mem_mapping_t *map;
+    uint32_t             buf[1024];
+    uint32_t             phys;
+    uint32_t             n;
+
+    if ((cpu_state.flags & D_FLAG) || (es == 0xffffffff) || (writelookup2[dest_addr >> 12] != (uintptr_t) LOOKUP_INV))
+        return 0;
+#ifdef USE_DEBUG_REGS_486
+    if (dr[7] & 0xff)
+        return 0;
+#endif
+
+    n = rep_block_len(dest_addr, dest, cnt, width, addr_size, cpu_state.seg_es.limit_high);
+    n = MIN(n, max);
+    if (n == 0)
+        return 0;
+
+    phys = rep_block_phys(dest_addr, width, 1);
+    if (phys == 0xffffffff)
+        return 0;
+    map = write_mapping[phys >> MEM_GRANULARITY_BITS];
+    if ((map == NULL) || (map->write_block == NULL))
+        return 0;
+
+    switch (width) {
+        case 1:
+            memset(buf, val & 0xff, n);
+            break;
+        case 2:
+            for (uint32_t i = 0; i < n; i++)
+                ((uint16_t *) buf)[i] = val & 0xffff;
+            break;
+        default:
+            for (uint32_t i = 0; i < n; i++)
+                buf[i] = val;
+            break;
+    }
+
+    return map->write_block(phys, buf, width, n, map->priv);
+}
+
 #ifdef OLD_DIVEXCP
 #    define divexcp()                                                                       \
         {                                                                                   \
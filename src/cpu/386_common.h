@@ -205,6 +205,11 @@
 
 int checkio(uint32_t port, int mask);
 
+extern uint32_t rep_ins_block(uint32_t dest, uint32_t cnt, int width, int addr_size);
+extern uint32_t rep_outs_block(x86seg *seg, uint32_t src, uint32_t cnt, int width, int addr_size);
+extern uint32_t rep_movs_block(x86seg *seg, uint32_t src, uint32_t dest, uint32_t cnt, int width, int addr_size, uint32_t max);
+extern uint32_t rep_stos_block(uint32_t dest, uint32_t cnt, int width, int addr_size, uint32_t max, uint32_t val);
+
 #define check_io_perm(port, size)                                    \
     if (msw & 1 && ((CPL > IOPL) || (cpu_state.eflags & VM_FLAG))) { \
         int tempi = checkio(port, (1 << size) - 1);                  \
@@ -7,28 +7,39 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint8_t temp;                                                                                         \
+            uint32_t blk;                                                                                         \
                                                                                                                   \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
             check_io_perm(DX, 1);                                                                                 \
             CHECK_WRITE(&cpu_state.seg_es, DEST_REG, DEST_REG);                                                   \
-            high_page = 0;                                                                                        \
-            do_mmut_wb(es, DEST_REG, &addr64);                                                                    \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-            temp = inb(DX);                                                                                       \
-            writememb_n(es, DEST_REG, addr64, temp);                                                              \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-                                                                                                                  \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                DEST_REG--;                                                                                       \
-            else                                                                                                  \
-                DEST_REG++;                                                                                       \
-            CNT_REG--;                                                                                            \
-            cycles -= 15;                                                                                         \
-            reads++;                                                                                              \
-            writes++;                                                                                             \
-            total_cycles += 15;                                                                                   \
+            blk = rep_ins_block(DEST_REG, CNT_REG, 1, sizeof(DEST_REG));                                          \
+            if (blk) {                                                                                            \
+                DEST_REG += blk;                                                                                  \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 15 * blk;                                                                               \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += 15 * blk;                                                                         \
+            } else {                                                                                              \
+                high_page = 0;                                                                                    \
+                do_mmut_wb(es, DEST_REG, &addr64);                                                                \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                temp = inb(DX);                                                                                   \
+                writememb_n(es, DEST_REG, addr64, temp);                                                          \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                                                                                                                  \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    DEST_REG--;                                                                                   \
+                else                                                                                              \
+                    DEST_REG++;                                                                                   \
+                CNT_REG--;                                                                                        \
+                cycles -= 15;                                                                                     \
+                reads++;                                                                                          \
+                writes++;                                                                                         \
+                total_cycles += 15;                                                                               \
+            }                                                                                                     \
         }                                                                                                         \
         PREFETCH_RUN(total_cycles, 1, -1, reads, 0, writes, 0, 0);                                                \
         if (CNT_REG > 0) {                                                                                        \
@@ -46,28 +57,39 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint16_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
                                                                                                                   \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
             check_io_perm(DX, 2);                                                                                 \
             CHECK_WRITE(&cpu_state.seg_es, DEST_REG, DEST_REG + 1UL);                                             \
-            high_page = 0;                                                                                        \
-            do_mmut_ww(es, DEST_REG, addr64a);                                                                    \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-            temp = inw(DX);                                                                                       \
-            writememw_n(es, DEST_REG, addr64a, temp);                                                             \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-                                                                                                                  \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                DEST_REG -= 2;                                                                                    \
-            else                                                                                                  \
-                DEST_REG += 2;                                                                                    \
-            CNT_REG--;                                                                                            \
-            cycles -= 15;                                                                                         \
-            reads++;                                                                                              \
-            writes++;                                                                                             \
-            total_cycles += 15;                                                                                   \
+            blk = rep_ins_block(DEST_REG, CNT_REG, 2, sizeof(DEST_REG));                                          \
+            if (blk) {                                                                                            \
+                DEST_REG += blk * 2;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 15 * blk;                                                                               \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += 15 * blk;                                                                         \
+            } else {                                                                                              \
+                high_page = 0;                                                                                    \
+                do_mmut_ww(es, DEST_REG, addr64a);                                                                \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                temp = inw(DX);                                                                                   \
+                writememw_n(es, DEST_REG, addr64a, temp);                                                         \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                                                                                                                  \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    DEST_REG -= 2;                                                                                \
+                else                                                                                              \
+                    DEST_REG += 2;                                                                                \
+                CNT_REG--;                                                                                        \
+                cycles -= 15;                                                                                     \
+                reads++;                                                                                          \
+                writes++;                                                                                         \
+                total_cycles += 15;                                                                               \
+            }                                                                                                     \
         }                                                                                                         \
         PREFETCH_RUN(total_cycles, 1, -1, reads, 0, writes, 0, 0);                                                \
         if (CNT_REG > 0) {                                                                                        \
@@ -85,28 +107,39 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint32_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
                                                                                                                   \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
             check_io_perm(DX, 4);                                                                                 \
             CHECK_WRITE(&cpu_state.seg_es, DEST_REG, DEST_REG + 3UL);                                             \
-            high_page = 0;                                                                                        \
-            do_mmut_wl(es, DEST_REG, addr64a);                                                                    \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-            temp = inl(DX);                                                                                       \
-            writememl_n(es, DEST_REG, addr64a, temp);                                                             \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-                                                                                                                  \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                DEST_REG -= 4;                                                                                    \
-            else                                                                                                  \
-                DEST_REG += 4;                                                                                    \
-            CNT_REG--;                                                                                            \
-            cycles -= 15;                                                                                         \
-            reads++;                                                                                              \
-            writes++;                                                                                             \
-            total_cycles += 15;                                                                                   \
+            blk = rep_ins_block(DEST_REG, CNT_REG, 4, sizeof(DEST_REG));                                          \
+            if (blk) {                                                                                            \
+                DEST_REG += blk * 4;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 15 * blk;                                                                               \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += 15 * blk;                                                                         \
+            } else {                                                                                              \
+                high_page = 0;                                                                                    \
+                do_mmut_wl(es, DEST_REG, addr64a);                                                                \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                temp = inl(DX);                                                                                   \
+                writememl_n(es, DEST_REG, addr64a, temp);                                                         \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                                                                                                                  \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    DEST_REG -= 4;                                                                                \
+                else                                                                                              \
+                    DEST_REG += 4;                                                                                \
+                CNT_REG--;                                                                                        \
+                cycles -= 15;                                                                                     \
+                reads++;                                                                                          \
+                writes++;                                                                                         \
+                total_cycles += 15;                                                                               \
+            }                                                                                                     \
         }                                                                                                         \
         PREFETCH_RUN(total_cycles, 1, -1, 0, reads, 0, writes, 0);                                                \
         if (CNT_REG > 0) {                                                                                        \
@@ -123,22 +156,33 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint8_t temp;                                                                                         \
+            uint32_t blk;                                                                                         \
             SEG_CHECK_READ(cpu_state.ea_seg);                                                                     \
             CHECK_READ(cpu_state.ea_seg, SRC_REG, SRC_REG);                                                       \
-            temp = readmemb(cpu_state.ea_seg->base, SRC_REG);                                                     \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
             check_io_perm(DX, 1);                                                                                 \
-            outb(DX, temp);                                                                                       \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                SRC_REG--;                                                                                        \
-            else                                                                                                  \
-                SRC_REG++;                                                                                        \
-            CNT_REG--;                                                                                            \
-            cycles -= 14;                                                                                         \
-            reads++;                                                                                              \
-            writes++;                                                                                             \
-            total_cycles += 14;                                                                                   \
+            blk = rep_outs_block(cpu_state.ea_seg, SRC_REG, CNT_REG, 1, sizeof(SRC_REG));                         \
+            if (blk) {                                                                                            \
+                SRC_REG += blk;                                                                                   \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 14 * blk;                                                                               \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += 14 * blk;                                                                         \
+            } else {                                                                                              \
+                temp = readmemb(cpu_state.ea_seg->base, SRC_REG);                                                 \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                outb(DX, temp);                                                                                   \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    SRC_REG--;                                                                                    \
+                else                                                                                              \
+                    SRC_REG++;                                                                                    \
+                CNT_REG--;                                                                                        \
+                cycles -= 14;                                                                                     \
+                reads++;                                                                                          \
+                writes++;                                                                                         \
+                total_cycles += 14;                                                                               \
+            }                                                                                                     \
         }                                                                                                         \
         PREFETCH_RUN(total_cycles, 1, -1, reads, 0, writes, 0, 0);                                                \
         if (CNT_REG > 0) {                                                                                        \
@@ -154,22 +198,33 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint16_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
             SEG_CHECK_READ(cpu_state.ea_seg);                                                                     \
             CHECK_READ(cpu_state.ea_seg, SRC_REG, SRC_REG + 1UL);                                                 \
-            temp = readmemw(cpu_state.ea_seg->base, SRC_REG);                                                     \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
             check_io_perm(DX, 2);                                                                                 \
-            outw(DX, temp);                                                                                       \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                SRC_REG -= 2;                                                                                     \
-            else                                                                                                  \
-                SRC_REG += 2;                                                                                     \
-            CNT_REG--;                                                                                            \
-            cycles -= 14;                                                                                         \
-            reads++;                                                                                              \
-            writes++;                                                                                             \
-            total_cycles += 14;                                                                                   \
+            blk = rep_outs_block(cpu_state.ea_seg, SRC_REG, CNT_REG, 2, sizeof(SRC_REG));                         \
+            if (blk) {                                                                                            \
+                SRC_REG += blk * 2;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 14 * blk;                                                                               \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += 14 * blk;                                                                         \
+            } else {                                                                                              \
+                temp = readmemw(cpu_state.ea_seg->base, SRC_REG);                                                 \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                outw(DX, temp);                                                                                   \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    SRC_REG -= 2;                                                                                 \
+                else                                                                                              \
+                    SRC_REG += 2;                                                                                 \
+                CNT_REG--;                                                                                        \
+                cycles -= 14;                                                                                     \
+                reads++;                                                                                          \
+                writes++;                                                                                         \
+                total_cycles += 14;                                                                               \
+            }                                                                                                     \
         }                                                                                                         \
         PREFETCH_RUN(total_cycles, 1, -1, reads, 0, writes, 0, 0);                                                \
         if (CNT_REG > 0) {                                                                                        \
@@ -185,22 +240,33 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint32_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
             SEG_CHECK_READ(cpu_state.ea_seg);                                                                     \
             CHECK_READ(cpu_state.ea_seg, SRC_REG, SRC_REG + 3UL);                                                 \
-            temp = readmeml(cpu_state.ea_seg->base, SRC_REG);                                                     \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
             check_io_perm(DX, 4);                                                                                 \
-            outl(DX, temp);                                                                                       \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                SRC_REG -= 4;                                                                                     \
-            else                                                                                                  \
-                SRC_REG += 4;                                                                                     \
-            CNT_REG--;                                                                                            \
-            cycles -= 14;                                                                                         \
-            reads++;                                                                                              \
-            writes++;                                                                                             \
-            total_cycles += 14;                                                                                   \
+            blk = rep_outs_block(cpu_state.ea_seg, SRC_REG, CNT_REG, 4, sizeof(SRC_REG));                         \
+            if (blk) {                                                                                            \
+                SRC_REG += blk * 4;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 14 * blk;                                                                               \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += 14 * blk;                                                                         \
+            } else {                                                                                              \
+                temp = readmeml(cpu_state.ea_seg->base, SRC_REG);                                                 \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                outl(DX, temp);                                                                                   \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    SRC_REG -= 4;                                                                                 \
+                else                                                                                              \
+                    SRC_REG += 4;                                                                                 \
+                CNT_REG--;                                                                                        \
+                cycles -= 14;                                                                                     \
+                reads++;                                                                                          \
+                writes++;                                                                                         \
+                total_cycles += 14;                                                                               \
+            }                                                                                                     \
         }                                                                                                         \
         PREFETCH_RUN(total_cycles, 1, -1, 0, reads, 0, writes, 0);                                                \
         if (CNT_REG > 0) {                                                                                        \
@@ -253,6 +319,17 @@
             reads++;                                                                                              \
             writes++;                                                                                             \
             total_cycles += is486 ? 3 : 4;                                                                        \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_movs_block(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 1, sizeof(DEST_REG),  \
+                                              (cycles - cycles_end) / (is486 ? 3 : 4));                           \
+                DEST_REG += blk;                                                                                  \
+                SRC_REG += blk;                                                                                   \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 3 : 4);                                                                  \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += blk * (is486 ? 3 : 4);                                                            \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -307,6 +384,17 @@
             reads++;                                                                                              \
             writes++;                                                                                             \
             total_cycles += is486 ? 3 : 4;                                                                        \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_movs_block(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 2, sizeof(DEST_REG),  \
+                                              (cycles - cycles_end) / (is486 ? 3 : 4));                           \
+                DEST_REG += blk * 2;                                                                              \
+                SRC_REG += blk * 2;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 3 : 4);                                                                  \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += blk * (is486 ? 3 : 4);                                                            \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -361,6 +449,17 @@
             reads++;                                                                                              \
             writes++;                                                                                             \
             total_cycles += is486 ? 3 : 4;                                                                        \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_movs_block(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 4, sizeof(DEST_REG),  \
+                                              (cycles - cycles_end) / (is486 ? 3 : 4));                           \
+                DEST_REG += blk * 4;                                                                              \
+                SRC_REG += blk * 4;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 3 : 4);                                                                  \
+                reads += blk;                                                                                     \
+                writes += blk;                                                                                    \
+                total_cycles += blk * (is486 ? 3 : 4);                                                            \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -394,6 +493,15 @@
             cycles -= is486 ? 4 : 5;                                                                              \
             writes++;                                                                                             \
             total_cycles += is486 ? 4 : 5;                                                                        \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_stos_block(DEST_REG, CNT_REG, 1, sizeof(DEST_REG),                             \
+                                              (cycles - cycles_end) / (is486 ? 4 : 5), AL);                       \
+                DEST_REG += blk;                                                                                  \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 4 : 5);                                                                  \
+                writes += blk;                                                                                    \
+                total_cycles += blk * (is486 ? 4 : 5);                                                            \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -426,6 +534,15 @@
             cycles -= is486 ? 4 : 5;                                                                              \
             writes++;                                                                                             \
             total_cycles += is486 ? 4 : 5;                                                                        \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_stos_block(DEST_REG, CNT_REG, 2, sizeof(DEST_REG),                             \
+                                              (cycles - cycles_end) / (is486 ? 4 : 5), AX);                       \
+                DEST_REG += blk * 2;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 4 : 5);                                                                  \
+                writes += blk;                                                                                    \
+                total_cycles += blk * (is486 ? 4 : 5);                                                            \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -458,6 +575,15 @@
             cycles -= is486 ? 4 : 5;                                                                              \
             writes++;                                                                                             \
             total_cycles += is486 ? 4 : 5;                                                                        \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_stos_block(DEST_REG, CNT_REG, 4, sizeof(DEST_REG),                             \
+                                              (cycles - cycles_end) / (is486 ? 4 : 5), EAX);                      \
+                DEST_REG += blk * 4;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 4 : 5);                                                                  \
+                writes += blk;                                                                                    \
+                total_cycles += blk * (is486 ? 4 : 5);                                                            \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -5,25 +5,33 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint8_t temp;                                                                                         \
+            uint32_t blk;                                                                                         \
                                                                                                                   \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
             check_io_perm(DX, 1);                                                                                 \
             CHECK_WRITE(&cpu_state.seg_es, DEST_REG, DEST_REG);                                                   \
-            high_page = 0;                                                                                        \
-            do_mmut_wb(es, DEST_REG, &addr64);                                                                    \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-            temp = inb(DX);                                                                                       \
-            writememb_n(es, DEST_REG, addr64, temp);                                                              \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
+            blk = rep_ins_block(DEST_REG, CNT_REG, 1, sizeof(DEST_REG));                                          \
+            if (blk) {                                                                                            \
+                DEST_REG += blk;                                                                                  \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 15 * blk;                                                                               \
+            } else {                                                                                              \
+                high_page = 0;                                                                                    \
+                do_mmut_wb(es, DEST_REG, &addr64);                                                                \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                temp = inb(DX);                                                                                   \
+                writememb_n(es, DEST_REG, addr64, temp);                                                          \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
                                                                                                                   \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                DEST_REG--;                                                                                       \
-            else                                                                                                  \
-                DEST_REG++;                                                                                       \
-            CNT_REG--;                                                                                            \
-            cycles -= 15;                                                                                         \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    DEST_REG--;                                                                                   \
+                else                                                                                              \
+                    DEST_REG++;                                                                                   \
+                CNT_REG--;                                                                                        \
+                cycles -= 15;                                                                                     \
+            }                                                                                                     \
         }                                                                                                         \
         if (CNT_REG > 0) {                                                                                        \
             CPU_BLOCK_END();                                                                                      \
@@ -38,25 +46,33 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint16_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
                                                                                                                   \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
             check_io_perm(DX, 2);                                                                                 \
             CHECK_WRITE(&cpu_state.seg_es, DEST_REG, DEST_REG + 1UL);                                             \
-            high_page = 0;                                                                                        \
-            do_mmut_ww(es, DEST_REG, addr64a);                                                                    \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-            temp = inw(DX);                                                                                       \
-            writememw_n(es, DEST_REG, addr64a, temp);                                                             \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
+            blk = rep_ins_block(DEST_REG, CNT_REG, 2, sizeof(DEST_REG));                                          \
+            if (blk) {                                                                                            \
+                DEST_REG += blk * 2;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 15 * blk;                                                                               \
+            } else {                                                                                              \
+                high_page = 0;                                                                                    \
+                do_mmut_ww(es, DEST_REG, addr64a);                                                                \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                temp = inw(DX);                                                                                   \
+                writememw_n(es, DEST_REG, addr64a, temp);                                                         \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
                                                                                                                   \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                DEST_REG -= 2;                                                                                    \
-            else                                                                                                  \
-                DEST_REG += 2;                                                                                    \
-            CNT_REG--;                                                                                            \
-            cycles -= 15;                                                                                         \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    DEST_REG -= 2;                                                                                \
+                else                                                                                              \
+                    DEST_REG += 2;                                                                                \
+                CNT_REG--;                                                                                        \
+                cycles -= 15;                                                                                     \
+            }                                                                                                     \
         }                                                                                                         \
         if (CNT_REG > 0) {                                                                                        \
             CPU_BLOCK_END();                                                                                      \
@@ -71,25 +87,33 @@
                                                                                                                   \
         if (CNT_REG > 0) {                                                                                        \
             uint32_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
                                                                                                                   \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
             check_io_perm(DX, 4);                                                                                 \
             CHECK_WRITE(&cpu_state.seg_es, DEST_REG, DEST_REG + 3UL);                                             \
-            high_page = 0;                                                                                        \
-            do_mmut_wl(es, DEST_REG, addr64a);                                                                    \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
-            temp = inl(DX);                                                                                       \
-            writememl_n(es, DEST_REG, addr64a, temp);                                                             \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
+            blk = rep_ins_block(DEST_REG, CNT_REG, 4, sizeof(DEST_REG));                                          \
+            if (blk) {                                                                                            \
+                DEST_REG += blk * 4;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 15 * blk;                                                                               \
+            } else {                                                                                              \
+                high_page = 0;                                                                                    \
+                do_mmut_wl(es, DEST_REG, addr64a);                                                                \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                temp = inl(DX);                                                                                   \
+                writememl_n(es, DEST_REG, addr64a, temp);                                                         \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
                                                                                                                   \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                DEST_REG -= 4;                                                                                    \
-            else                                                                                                  \
-                DEST_REG += 4;                                                                                    \
-            CNT_REG--;                                                                                            \
-            cycles -= 15;                                                                                         \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    DEST_REG -= 4;                                                                                \
+                else                                                                                              \
+                    DEST_REG += 4;                                                                                \
+                CNT_REG--;                                                                                        \
+                cycles -= 15;                                                                                     \
+            }                                                                                                     \
         }                                                                                                         \
         if (CNT_REG > 0) {                                                                                        \
             CPU_BLOCK_END();                                                                                      \
@@ -103,19 +127,27 @@
     {                                                                                                             \
         if (CNT_REG > 0) {                                                                                        \
             uint8_t temp;                                                                                         \
+            uint32_t blk;                                                                                         \
             SEG_CHECK_READ(cpu_state.ea_seg);                                                                     \
             CHECK_READ(cpu_state.ea_seg, SRC_REG, SRC_REG);                                                       \
-            temp = readmemb(cpu_state.ea_seg->base, SRC_REG);                                                     \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
             check_io_perm(DX, 1);                                                                                 \
-            outb(DX, temp);                                                                                       \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                SRC_REG--;                                                                                        \
-            else                                                                                                  \
-                SRC_REG++;                                                                                        \
-            CNT_REG--;                                                                                            \
-            cycles -= 14;                                                                                         \
+            blk = rep_outs_block(cpu_state.ea_seg, SRC_REG, CNT_REG, 1, sizeof(SRC_REG));                         \
+            if (blk) {                                                                                            \
+                SRC_REG += blk;                                                                                   \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 14 * blk;                                                                               \
+            } else {                                                                                              \
+                temp = readmemb(cpu_state.ea_seg->base, SRC_REG);                                                 \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                outb(DX, temp);                                                                                   \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    SRC_REG--;                                                                                    \
+                else                                                                                              \
+                    SRC_REG++;                                                                                    \
+                CNT_REG--;                                                                                        \
+                cycles -= 14;                                                                                     \
+            }                                                                                                     \
         }                                                                                                         \
         if (CNT_REG > 0) {                                                                                        \
             CPU_BLOCK_END();                                                                                      \
@@ -128,19 +160,27 @@
     {                                                                                                             \
         if (CNT_REG > 0) {                                                                                        \
             uint16_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
             SEG_CHECK_READ(cpu_state.ea_seg);                                                                     \
             CHECK_READ(cpu_state.ea_seg, SRC_REG, SRC_REG + 1UL);                                                 \
-            temp = readmemw(cpu_state.ea_seg->base, SRC_REG);                                                     \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
             check_io_perm(DX, 2);                                                                                 \
-            outw(DX, temp);                                                                                       \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                SRC_REG -= 2;                                                                                     \
-            else                                                                                                  \
-                SRC_REG += 2;                                                                                     \
-            CNT_REG--;                                                                                            \
-            cycles -= 14;                                                                                         \
+            blk = rep_outs_block(cpu_state.ea_seg, SRC_REG, CNT_REG, 2, sizeof(SRC_REG));                         \
+            if (blk) {                                                                                            \
+                SRC_REG += blk * 2;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 14 * blk;                                                                               \
+            } else {                                                                                              \
+                temp = readmemw(cpu_state.ea_seg->base, SRC_REG);                                                 \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                outw(DX, temp);                                                                                   \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    SRC_REG -= 2;                                                                                 \
+                else                                                                                              \
+                    SRC_REG += 2;                                                                                 \
+                CNT_REG--;                                                                                        \
+                cycles -= 14;                                                                                     \
+            }                                                                                                     \
         }                                                                                                         \
         if (CNT_REG > 0) {                                                                                        \
             CPU_BLOCK_END();                                                                                      \
@@ -153,19 +193,27 @@
     {                                                                                                             \
         if (CNT_REG > 0) {                                                                                        \
             uint32_t temp;                                                                                        \
+            uint32_t blk;                                                                                         \
             SEG_CHECK_READ(cpu_state.ea_seg);                                                                     \
             CHECK_READ(cpu_state.ea_seg, SRC_REG, SRC_REG + 3UL);                                                 \
-            temp = readmeml(cpu_state.ea_seg->base, SRC_REG);                                                     \
-            if (cpu_state.abrt)                                                                                   \
-                return 1;                                                                                         \
             check_io_perm(DX, 4);                                                                                 \
-            outl(DX, temp);                                                                                       \
-            if (cpu_state.flags & D_FLAG)                                                                         \
-                SRC_REG -= 4;                                                                                     \
-            else                                                                                                  \
-                SRC_REG += 4;                                                                                     \
-            CNT_REG--;                                                                                            \
-            cycles -= 14;                                                                                         \
+            blk = rep_outs_block(cpu_state.ea_seg, SRC_REG, CNT_REG, 4, sizeof(SRC_REG));                         \
+            if (blk) {                                                                                            \
+                SRC_REG += blk * 4;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= 14 * blk;                                                                               \
+            } else {                                                                                              \
+                temp = readmeml(cpu_state.ea_seg->base, SRC_REG);                                                 \
+                if (cpu_state.abrt)                                                                               \
+                    return 1;                                                                                     \
+                outl(DX, temp);                                                                                   \
+                if (cpu_state.flags & D_FLAG)                                                                     \
+                    SRC_REG -= 4;                                                                                 \
+                else                                                                                              \
+                    SRC_REG += 4;                                                                                 \
+                CNT_REG--;                                                                                        \
+                cycles -= 14;                                                                                     \
+            }                                                                                                     \
         }                                                                                                         \
         if (CNT_REG > 0) {                                                                                        \
             CPU_BLOCK_END();                                                                                      \
@@ -213,6 +261,14 @@
             }                                                                                                     \
             CNT_REG--;                                                                                            \
             cycles -= is486 ? 3 : 4;                                                                              \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_movs_block(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 1, sizeof(DEST_REG),  \
+                                              (cycles - cycles_end) / (is486 ? 3 : 4));                           \
+                DEST_REG += blk;                                                                                  \
+                SRC_REG += blk;                                                                                   \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 3 : 4);                                                                  \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -262,6 +318,14 @@
             }                                                                                                     \
             CNT_REG--;                                                                                            \
             cycles -= is486 ? 3 : 4;                                                                              \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_movs_block(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 2, sizeof(DEST_REG),  \
+                                              (cycles - cycles_end) / (is486 ? 3 : 4));                           \
+                DEST_REG += blk * 2;                                                                              \
+                SRC_REG += blk * 2;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 3 : 4);                                                                  \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -311,6 +375,14 @@
             }                                                                                                     \
             CNT_REG--;                                                                                            \
             cycles -= is486 ? 3 : 4;                                                                              \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_movs_block(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 4, sizeof(DEST_REG),  \
+                                              (cycles - cycles_end) / (is486 ? 3 : 4));                           \
+                DEST_REG += blk * 4;                                                                              \
+                SRC_REG += blk * 4;                                                                               \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 3 : 4);                                                                  \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -340,6 +412,13 @@
                 DEST_REG++;                                                                                       \
             CNT_REG--;                                                                                            \
             cycles -= is486 ? 4 : 5;                                                                              \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_stos_block(DEST_REG, CNT_REG, 1, sizeof(DEST_REG),                             \
+                                              (cycles - cycles_end) / (is486 ? 4 : 5), AL);                       \
+                DEST_REG += blk;                                                                                  \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 4 : 5);                                                                  \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -368,6 +447,13 @@
                 DEST_REG += 2;                                                                                    \
             CNT_REG--;                                                                                            \
             cycles -= is486 ? 4 : 5;                                                                              \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_stos_block(DEST_REG, CNT_REG, 2, sizeof(DEST_REG),                             \
+                                              (cycles - cycles_end) / (is486 ? 4 : 5), AX);                       \
+                DEST_REG += blk * 2;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 4 : 5);                                                                  \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
@@ -396,6 +482,13 @@
                 DEST_REG += 4;                                                                                    \
             CNT_REG--;                                                                                            \
             cycles -= is486 ? 4 : 5;                                                                              \
+            if ((CNT_REG > 0) && (cycles >= cycles_end)) {                                                        \
+                uint32_t blk = rep_stos_block(DEST_REG, CNT_REG, 4, sizeof(DEST_REG),                             \
+                                              (cycles - cycles_end) / (is486 ? 4 : 5), EAX);                      \
+                DEST_REG += blk * 4;                                                                              \
+                CNT_REG -= blk;                                                                                   \
+                cycles -= blk * (is486 ? 4 : 5);                                                                  \
+            }                                                                                                     \
             if (cycles < cycles_end)                                                                              \
                 break;                                                                                            \
         }                                                                                                         \
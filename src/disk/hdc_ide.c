@@ -1475,6 +1475,30 @@ ide_writel(uint16_t addr, uint32_t val, void *priv)
     }
 }
 
+/*
+ * Block version of the data port for REP OUTSW/OUTSD. Stops short of the last
+ * word of the sector so ide_write_data() still starts the write.
+ */
+static int
+ide_write_block(uint16_t addr, const void *buf, int width, int count, void *priv)
+{
+    const ide_board_t *dev = (ide_board_t *) priv;
+    ide_t             *ide = ide_drives[dev->cur_dev];
+
+    if (((addr & 0x7) != 0x0) || ((width != 2) && ((width != 4) || !dev->bit32)) ||
+        (ide->type == IDE_NONE) || (ide->type & IDE_SHADOW) || (ide->buffer == NULL) ||
+        (ide->command == WIN_PACKETCMD) || (ide->tf->pos >= 510))
+        return 0;
+
+    count = MIN(count, (510 - ide->tf->pos) / width);
+    if (count > 0) {
+        memcpy((uint8_t *) ide->buffer + ide->tf->pos, buf, count * width);
+        ide->tf->pos += count * width;
+    }
+
+    return count;
+}
+
 static void
 dev_reset(ide_t *ide)
 {
@@ -2227,6 +2251,27 @@ ide_readl(uint16_t addr, void *priv)
     return ret;
 }
 
+/* Block version of the data port for REP INSW/INSD, see ide_write_block(). */
+static int
+ide_read_block(uint16_t addr, void *buf, int width, int count, void *priv)
+{
+    const ide_board_t *dev = (ide_board_t *) priv;
+    ide_t             *ide = ide_drives[dev->cur_dev];
+
+    if (((addr & 0x7) != 0x0) || ((width != 2) && ((width != 4) || !dev->bit32)) ||
+        (ide->type == IDE_NONE) || (ide->type & IDE_SHADOW) || (ide->buffer == NULL) ||
+        (ide->command == WIN_PACKETCMD) || (ide->tf->pos >= 510))
+        return 0;
+
+    count = MIN(count, (510 - ide->tf->pos) / width);
+    if (count > 0) {
+        memcpy(buf, (uint8_t *) ide->buffer + ide->tf->pos, count * width);
+        ide->tf->pos += count * width;
+    }
+
+    return count;
+}
+
 static void
 ide_board_callback(void *priv)
 {
@@ -2770,6 +2815,10 @@ ide_handlers(uint8_t board, int set)
                        ide_readb, ide_readw, ide_readl,
                        ide_writeb, ide_writew, ide_writel,
                        ide_boards[board]);
+            if (set)
+                io_set_block_handler(ide_boards[board]->base[0], 1,
+                                     ide_read_block, ide_write_block,
+                                     ide_boards[board]);
         }
 
         if (ide_boards[board]->base[1]) {
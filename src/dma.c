@@ -1874,15 +1874,20 @@ dma_bm_read(uint32_t PhysAddress, uint8_t *DataRead, uint32_t TotalSize, int Tra
 {
     uint32_t n;
     uint32_t n2;
+    uint32_t chunk;
     uint8_t  bytes[4] = { 0, 0, 0, 0 };
 
     n  = TotalSize & ~(TransferSize - 1);
     n2 = TotalSize - n;
 
-    /* Do the divisible block, if there is one. */
-    if (n) {
-        for (uint32_t i = 0; i < n; i += TransferSize)
+    /* Do the divisible block, if there is one, a page at a time where the target allows it. */
+    for (uint32_t i = 0; i < n;) {
+        chunk = mem_read_phys_block((void *) &(DataRead[i]), PhysAddress + i, n - i, TransferSize);
+        if (chunk == 0) {
             mem_read_phys((void *) &(DataRead[i]), PhysAddress + i, TransferSize);
+            chunk = TransferSize;
+        }
+        i += chunk;
     }
 
     /* Do the non-divisible block, if there is one. */
@@ -1897,15 +1902,20 @@ dma_bm_write(uint32_t PhysAddress, const uint8_t *DataWrite, uint32_t TotalSize,
 {
     uint32_t n;
     uint32_t n2;
+    uint32_t chunk;
     uint8_t  bytes[4] = { 0, 0, 0, 0 };
 
     n  = TotalSize & ~(TransferSize - 1);
     n2 = TotalSize - n;
 
-    /* Do the divisible block, if there is one. */
-    if (n) {
-        for (uint32_t i = 0; i < n; i += TransferSize)
+    /* Do the divisible block, if there is one, a page at a time where the target allows it. */
+    for (uint32_t i = 0; i < n;) {
+        chunk = mem_write_phys_block((const void *) &(DataWrite[i]), PhysAddress + i, n - i, TransferSize);
+        if (chunk == 0) {
             mem_write_phys((void *) &(DataWrite[i]), PhysAddress + i, TransferSize);
+            chunk = TransferSize;
+        }
+        i += chunk;
     }
 
     /* Do the non-divisible block, if there is one. */
@@ -45,6 +45,10 @@
 #define VMM_PATH		   "Virtual Machines"
 #define VMM_PATH_WINDOWS   "86Box VMs"
 
+/* Format of raw screenshots; the PPM one is not compressed at all. */
+#define SCREENSHOT_FORMAT_PNG 0
+#define SCREENSHOT_FORMAT_PPM 1
+
 /* Recently used images */
 #define MAX_PREV_IMAGES    10
 #define MAX_IMAGE_PATH_LEN 4096
@@ -58,6 +62,17 @@
 #define POSTCARDS_NUM 4
 #define POSTCARD_MASK (POSTCARDS_NUM - 1)
 
+#define SPEED_MULT_MAX 8
+
+/* Host threads that can be given their own CPU affinity. */
+enum {
+    THREAD_ROLE_EMU = 0,
+    THREAD_ROLE_BLIT,
+    THREAD_ROLE_VOODOO,
+    THREAD_ROLE_SOUND,
+    THREAD_ROLE_MAX
+};
+
 #ifdef MIN
 #    undef MIN
 #endif
@@ -194,6 +209,11 @@ extern int      force_43;                   /* (C) video */
 extern int      video_filter_method;        /* (C) video */
 extern int      video_vsync;                /* (C) video */
 extern int      video_framerate;            /* (C) video */
+extern int      video_frameskip;            /* (C) video */
+extern int      video_render_thread;        /* (C) video */
+extern int      screenshot_format;          /* (C) video */
+extern int      screenshot_compression;     /* (C) video */
+extern int      capture_enabled;            /* (C) record audio and video */
 extern double   video_gl_input_scale;       /* (C) OpenGL 3.x input scale */
 extern int      video_gl_input_scale_mode;  /* (C) OpenGL 3.x input stretch mode */
 extern int      gfxcard[GFXCARD_MAX];       /* (C) graphics/video card */
@@ -223,6 +243,10 @@ extern int      confirm_exit;               /* (G) enable exit confirmation */
 extern int      confirm_save;               /* (G) enable save confirmation */
 extern int      enable_discord;             /* (C) enable Discord integration */
 extern int      force_10ms;                 /* (C) force 10ms CPU frame interval */
+extern int      speed_mult;                 /* (C) guest speed multiplier */
+extern char     thread_affinity[THREAD_ROLE_MAX][128]; /* (C) host CPUs per thread role */
+extern int      emu_thread_priority;        /* (C) emulation thread priority */
+extern const char *thread_role_names[THREAD_ROLE_MAX];
 extern int      jumpered_internal_ecp_dma;  /* (C) Jumpered internal EPC DMA */
 extern int      other_ide_present;          /* IDE controllers from non-IDE cards are present */
 extern int      other_scsi_present;         /* SCSI controllers from non-SCSI cards are present */
@@ -298,6 +322,8 @@ extern void pc_close(void *threadid);
 extern void pc_reset_hard_close(void);
 extern void pc_reset_hard_init(void);
 extern void pc_reset_hard(void);
+extern void pc_cycle_speed(void);
+extern void pc_thread_setup(int role);
 extern void pc_full_speed(void);
 extern void pc_speed_changed(void);
 extern void pc_send_cad(void);
@@ -334,7 +360,7 @@ struct accelKey {
 	char desc[64];
 	char seq[64];
 };
-#define NUM_ACCELS 14
+#define NUM_ACCELS 15
 extern struct accelKey acc_keys[NUM_ACCELS];
 extern struct accelKey def_acc_keys[NUM_ACCELS];
 extern int FindAccelerator(const char *name);
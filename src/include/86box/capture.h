@@ -0,0 +1,33 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Header of the audio and video recorder.
+ *
+ * Authors: agent, <agent@local>
+ *
+ *          Copyright 2025 agent.
+ */
+#ifndef EMU_CAPTURE_H
+#define EMU_CAPTURE_H
+
+#define CAPTURE_PATH "recordings"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void capture_start(void);
+extern void capture_stop(void);
+extern int  capture_active(void);
+extern void capture_poll(const int32_t *buf, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_CAPTURE_H*/
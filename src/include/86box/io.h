@@ -101,6 +101,11 @@ extern void io_handler_interleaved(int set, uint16_t base, int size,
                                    void (*outl)(uint16_t addr, uint32_t val, void *priv),
                                    void *priv);
 
+extern void io_set_block_handler(uint16_t base, int size,
+                                 int (*inblock)(uint16_t addr, void *buf, int width, int count, void *priv),
+                                 int (*outblock)(uint16_t addr, const void *buf, int width, int count, void *priv),
+                                 void *priv);
+
 extern uint8_t  inb(uint16_t port);
 extern void     outb(uint16_t port, uint8_t val);
 extern uint16_t inw(uint16_t port);
@@ -108,6 +113,9 @@ extern void     outw(uint16_t port, uint16_t val);
 extern uint32_t inl(uint16_t port);
 extern void     outl(uint16_t port, uint32_t val);
 
+extern int io_read_block(uint16_t port, void *buf, int width, int count);
+extern int io_write_block(uint16_t port, const void *buf, int width, int count);
+
 extern void *io_trap_add(void (*func)(int size, uint16_t addr, uint8_t write, uint8_t val, void *priv),
                          void *priv);
 extern void  io_trap_remap(void *handle, int enable, uint16_t addr, uint16_t size);
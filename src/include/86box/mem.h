@@ -186,6 +186,11 @@ typedef struct _mem_mapping_ {
     void (*write_w)(uint32_t addr, uint16_t val, void *priv);
     void (*write_l)(uint32_t addr, uint32_t val, void *priv);
 
+    /* Optional bulk handlers for count elements of width bytes, never crossing a 4K page.
+       They return the number of elements handled, 0 to fall back to the handlers above. */
+    uint32_t (*read_block)(uint32_t addr, void *buf, int width, uint32_t count, void *priv);
+    uint32_t (*write_block)(uint32_t addr, const void *buf, int width, uint32_t count, void *priv);
+
     uint8_t *exec;
 
     uint32_t flags;
@@ -356,6 +361,7 @@ extern uint64_t mmutranslatereal(uint32_t addr, int rw);
 extern uint32_t mmutranslatereal32(uint32_t addr, int rw);
 extern void     addreadlookup(uint32_t virt, uint32_t phys);
 extern void     addwritelookup(uint32_t virt, uint32_t phys);
+extern void     addwritelookup_direct(uint32_t virt, uint8_t *ptr);
 
 extern void mem_mapping_set(mem_mapping_t *,
                             uint32_t base,
@@ -395,6 +401,10 @@ extern void mem_mapping_set_write_handler(mem_mapping_t *,
                                           void (*write_w)(uint32_t addr, uint16_t val, void *priv),
                                           void (*write_l)(uint32_t addr, uint32_t val, void *priv));
 
+extern void mem_mapping_set_block_handler(mem_mapping_t *,
+                                          uint32_t (*read_block)(uint32_t addr, void *buf, int width, uint32_t count, void *priv),
+                                          uint32_t (*write_block)(uint32_t addr, const void *buf, int width, uint32_t count, void *priv));
+
 extern void mem_mapping_set_p(mem_mapping_t *, void *priv);
 
 extern void mem_mapping_set_addr(mem_mapping_t *,
@@ -417,6 +427,8 @@ extern void     mem_writeb_phys(uint32_t addr, uint8_t val);
 extern void     mem_writew_phys(uint32_t addr, uint16_t val);
 extern void     mem_writel_phys(uint32_t addr, uint32_t val);
 extern void     mem_write_phys(void *src, uint32_t addr, int tranfer_size);
+extern uint32_t mem_read_phys_block(void *dest, uint32_t addr, uint32_t len, int transfer_size);
+extern uint32_t mem_write_phys_block(const void *src, uint32_t addr, uint32_t len, int transfer_size);
 
 extern uint8_t  mem_read_ram(uint32_t addr, void *priv);
 extern uint16_t mem_read_ramw(uint32_t addr, void *priv);
@@ -442,6 +454,7 @@ extern void mem_write_ramb_page(uint32_t addr, uint8_t val, page_t *page);
 extern void mem_write_ramw_page(uint32_t addr, uint16_t val, page_t *page);
 extern void mem_write_raml_page(uint32_t addr, uint32_t val, page_t *page);
 extern void mem_flush_write_page(uint32_t addr, uint32_t virt);
+extern void mem_flush_write_direct(void);
 
 extern void mem_reset_page_blocks(void);
 
@@ -0,0 +1,36 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Header of the deadline-based pacing of the emulation thread.
+ *
+ * Authors: agent, <agent@local>
+ *
+ *          Copyright 2025 agent.
+ */
+#ifndef EMU_PACE_H
+#define EMU_PACE_H
+
+/* Lateness buckets: < 0.1, < 0.25, < 0.5, < 1, < 2, < 5, < 10, >= 10 ms. */
+#define PACE_LATE_BUCKETS 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint64_t pace_time_ns(void);
+extern void     pace_reset(uint32_t period_ms);
+extern int      pace_due(uint32_t period_ms);
+extern void     pace_wait(void);
+extern int      pace_behind(void);
+extern void     pace_get_lateness(uint64_t *buckets, uint64_t *dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_PACE_H*/
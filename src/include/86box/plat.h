@@ -155,6 +155,8 @@ extern void     plat_get_cpu_string(char *outbuf, uint8_t len);
 extern void     plat_get_system_directory(char *outbuf);
 #endif
 extern void     plat_set_thread_name(void *thread, const char *name);
+extern void     plat_set_thread_affinity(uint64_t mask);
+extern void     plat_set_thread_priority(int level);
 extern void     plat_break(void);
 extern void     plat_send_to_clipboard(unsigned char *rgb, int width, int height);
 
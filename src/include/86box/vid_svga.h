@@ -53,10 +53,22 @@ typedef union {
     uint8_t  b[8];
 } latch_t;
 
+struct svga_pipeline_t;
+
+/* Why the render thread's copy of the state has to be refreshed before the
+   next line is queued, see svga_pipeline_resync(). */
+#define SVGA_RESYNC_STATE 1 /* a register the renderers read written */
+#define SVGA_RESYNC_FRAME 2 /* new frame */
+
 typedef struct svga_t {
     mem_mapping_t mapping;
 
     uint8_t fast;
+    /* Card allows fast-mode linear frame buffer pages to be written by the
+       CPU directly; its LFB mapping uses the svga_write*_lfb() handlers. */
+    uint8_t direct_lfb;
+    /* The current frame is not drawn, see video_skip_frame(). */
+    uint8_t frame_skip;
     uint8_t chain4;
     uint8_t chain2_write;
     uint8_t chain2_read;
@@ -114,6 +126,11 @@ typedef struct svga_t {
     int lastline;
     int firstline_draw;
     int lastline_draw;
+    /* Target buffer rows drawn since the dirty range was last reported to
+       the blitter; empty while dirty_y1 >= dirty_y2. */
+    int dirty_y1;
+    int dirty_y2;
+    uint32_t dirty_overscan_color;
     int displine;
     int fullchange;
     int left_overscan;
@@ -331,6 +348,19 @@ typedef struct svga_t {
     void *     priv_parent;
 
     void *     local;
+
+    /* Scanline render thread, NULL when lines are drawn inline. */
+    struct svga_pipeline_t *pipeline;
+    int                     render_resync;
+
+    /* Expanded text mode glyph rows. */
+    glyph_cache_t *glyph_cache;
+
+    /* Planar write handler for the current write mode, logical operation
+       and set/reset state, NULL where only svga_write_common() applies;
+       reselected when the state in write_planes_key changes. */
+    void (*write_planes)(struct svga_t *svga, uint32_t addr, uint8_t val, int writemask2);
+    uint32_t write_planes_key;
 } svga_t;
 
 extern void     ibm8514_set_poll(svga_t *svga);
@@ -390,6 +420,17 @@ void     svga_write_linear(uint32_t addr, uint8_t val, void *priv);
 void     svga_writeb_linear(uint32_t addr, uint8_t val, void *priv);
 void     svga_writew_linear(uint32_t addr, uint16_t val, void *priv);
 void     svga_writel_linear(uint32_t addr, uint32_t val, void *priv);
+void     svga_writeb_lfb(uint32_t addr, uint8_t val, void *priv);
+void     svga_writew_lfb(uint32_t addr, uint16_t val, void *priv);
+void     svga_writel_lfb(uint32_t addr, uint32_t val, void *priv);
+uint32_t svga_read_block(uint32_t addr, void *buf, int width, uint32_t count, void *priv);
+uint32_t svga_read_block_linear(uint32_t addr, void *buf, int width, uint32_t count, void *priv);
+uint32_t svga_write_block(uint32_t addr, const void *buf, int width, uint32_t count, void *priv);
+uint32_t svga_write_block_linear(uint32_t addr, const void *buf, int width, uint32_t count, void *priv);
+
+void svga_blit_changed(svga_t *svga, uint32_t addr, uint32_t len);
+void svga_blit_copy(svga_t *svga, uint32_t dst, uint32_t src, uint32_t len, int backwards);
+void svga_blit_fill(svga_t *svga, uint32_t dst, uint32_t col, int bytes_pp, uint32_t count);
 
 void svga_add_status_info(char *s, int max_len, void *priv);
 
@@ -417,6 +458,7 @@ enum {
 };
 
 uint32_t svga_lookup_lut_ram(svga_t* svga, uint32_t val);
+uint32_t svga_conv_16to32(struct svga_t *svga, uint16_t color, uint8_t bpp);
 
 /* We need a way to add a device with a pointer to a parent device so it can attach itself to it, and
    possibly also a second ATi 68860 RAM DAC type that auto-sets SVGA render on RAM DAC render change. */
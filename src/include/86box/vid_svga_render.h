@@ -34,6 +34,7 @@ extern uint8_t edatlookup[4][4];
 extern uint8_t egaremap2bpp[256];
 
 extern void svga_recalc_remap_func(svga_t *svga);
+extern int  svga_render_8bpp_is_linear(svga_t *svga);
 
 extern void svga_render_null(svga_t *svga);
 extern void svga_render_blank(svga_t *svga);
@@ -83,4 +84,22 @@ extern void ibm8514_render_RGBA8888(svga_t *svga);
 
 extern void (*svga_render)(svga_t *svga);
 
+/* Scanline conversion kernels, picked for the host CPU by svga_render_simd_init(). */
+extern void (*svga_line_8to32)(uint32_t *dst, const uint8_t *src, const uint32_t *pal, uint8_t mask, int count);
+extern void (*svga_line_15to32)(uint32_t *dst, const uint16_t *src, int count);
+extern void (*svga_line_16to32)(uint32_t *dst, const uint16_t *src, int count);
+extern void (*svga_line_24to32)(uint32_t *dst, const uint8_t *src, int count);
+extern void (*svga_line_32to32)(uint32_t *dst, const uint32_t *src, int count);
+
+/* Layout of the YUV 4:2:2 input to svga_line_yuv422to32(): luma in the odd
+   bytes rather than the even ones, Cr (V) as the first chroma byte of a
+   pair, and red in the low byte of the output. */
+#define SVGA_YUV_Y_ODD   1
+#define SVGA_YUV_V_FIRST 2
+#define SVGA_YUV_BGR     4
+
+extern void (*svga_line_yuv422to32)(uint32_t *dst, const uint8_t *src, int fmt, int count);
+
+extern void svga_render_simd_init(void);
+
 #endif /*VID_SVGA_RENDER_H*/
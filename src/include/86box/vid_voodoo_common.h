@@ -26,8 +26,12 @@
 #define LOD_MAX         8
 
 #define TEX_DIRTY_SHIFT 10
+#define TEX_PAGES       16384
 
-#define TEX_CACHE_MAX   64
+/* The texture cache is sized by TMU memory, between these two. */
+#define TEX_CACHE_MIN   64
+#define TEX_CACHE_MAX   256
+#define TEX_HASH_SIZE   256
 
 enum {
     VOODOO_1 = 0,
@@ -70,6 +74,8 @@ typedef union rgba_u {
 #define FIFO_MASK       (FIFO_SIZE - 1)
 #define FIFO_ENTRY_SIZE (1 << 31)
 
+#define VOODOO_CACHE_LINE 64
+
 #define FIFO_ENTRIES    (voodoo->fifo_write_idx - voodoo->fifo_read_idx)
 #define FIFO_FULL       ((voodoo->fifo_write_idx - voodoo->fifo_read_idx) >= FIFO_SIZE - 4)
 #define FIFO_EMPTY      (voodoo->fifo_read_idx == voodoo->fifo_write_idx)
@@ -101,6 +107,10 @@ enum {
 #define PARAM_FULL(x)    ((voodoo->params_write_idx - voodoo->params_read_idx[x]) >= PARAM_SIZE)
 #define PARAM_EMPTY(x)   (voodoo->params_read_idx[x] == voodoo->params_write_idx)
 
+/* Each render thread owns every render_threads-th band of scanlines. */
+#define VOODOO_MAX_RENDER_THREADS 16
+#define VOODOO_RENDER_BAND_SHIFT  2
+
 typedef struct
 {
     uint32_t addr_type;
@@ -233,12 +243,14 @@ typedef struct texture_t {
     uint32_t   base;
     uint32_t   tLOD;
     ATOMIC_INT refcount;
-    ATOMIC_INT refcount_r[4];
+    ATOMIC_INT refcount_r[VOODOO_MAX_RENDER_THREADS];
     int        is16;
     uint32_t   palette_checksum;
     uint32_t   addr_start[4];
     uint32_t   addr_end[4];
     uint32_t  *data;
+    int        hash;
+    int        hash_next;
 } texture_t;
 
 typedef struct vert_t {
@@ -361,27 +373,31 @@ typedef struct voodoo_t {
     int    ncc_dirty[2];
 
     thread_t *fifo_thread;
-    thread_t *render_thread[4];
+    thread_t *render_thread[VOODOO_MAX_RENDER_THREADS];
     event_t  *wake_fifo_thread;
     event_t  *wake_main_thread;
     event_t  *fifo_not_full_event;
     event_t  *fifo_empty_event;
     ATOMIC_INT fifo_empty_signaled;
-    event_t  *render_not_full_event[4];
-    event_t  *wake_render_thread[4];
+    event_t  *render_not_full_event[VOODOO_MAX_RENDER_THREADS];
+    event_t  *wake_render_thread[VOODOO_MAX_RENDER_THREADS];
 
     int voodoo_busy;
-    int render_voodoo_busy[4];
+    int render_voodoo_busy[VOODOO_MAX_RENDER_THREADS];
 
     int render_threads;
-    int odd_even_mask;
 
-    int pixel_count[4];
-    int texel_count[4];
+    struct voodoo_render_slot_t {
+        struct voodoo_t *voodoo;
+        int              index;
+    } render_slot[VOODOO_MAX_RENDER_THREADS];
+
+    int pixel_count[VOODOO_MAX_RENDER_THREADS];
+    int texel_count[VOODOO_MAX_RENDER_THREADS];
     int tri_count;
     int frame_count;
-    int pixel_count_old[4];
-    int texel_count_old[4];
+    int pixel_count_old[VOODOO_MAX_RENDER_THREADS];
+    int texel_count_old[VOODOO_MAX_RENDER_THREADS];
     int wr_count;
     int rd_count;
     int tex_count;
@@ -404,8 +420,15 @@ typedef struct voodoo_t {
     int type;
 
     fifo_entry_t fifo[FIFO_SIZE];
+    /*The read index is only written by the FIFO thread and the write index
+      only by the CPU thread; keep them on separate cache lines so the two
+      sides don't keep stealing the line from each other.*/
+    uint8_t      fifo_pad0[VOODOO_CACHE_LINE];
     ATOMIC_INT   fifo_read_idx;
+    uint8_t      fifo_pad1[VOODOO_CACHE_LINE - sizeof(int)];
     ATOMIC_INT   fifo_write_idx;
+    uint8_t      fifo_pad2[VOODOO_CACHE_LINE - sizeof(int)];
+    int          fifo_spin_limit;
     ATOMIC_INT   cmd_read;
     ATOMIC_INT   cmd_written;
     ATOMIC_INT   cmd_written_fifo;
@@ -414,7 +437,7 @@ typedef struct voodoo_t {
     ATOMIC_INT   pending_draw_cmds_buf[VOODOO_BUF_COUNT];
 
     voodoo_params_t params_buffer[PARAM_SIZE];
-    ATOMIC_INT      params_read_idx[4];
+    ATOMIC_INT      params_read_idx[VOODOO_MAX_RENDER_THREADS];
     ATOMIC_INT      params_write_idx;
 
     uint32_t   cmdfifo_base;
@@ -667,15 +690,18 @@ typedef struct voodoo_t {
     uint8_t  thefilterb[256][256];
     uint16_t purpleline[256][3];
 
-    texture_t texture_cache[2][TEX_CACHE_MAX];
-    uint8_t   texture_present[2][16384];
-    int       texture_last_removed;
+    texture_t *texture_cache[2];
+    int        texture_cache_size;
+    int        texture_hash[2][TEX_HASH_SIZE];
+    uint64_t  *texture_users[2]; /*Per page bitmap of the cache entries decoded from it*/
+    uint8_t    texture_present[2][TEX_PAGES];
+    int        texture_last_removed;
 
     uint32_t palette_checksum[2];
     int      palette_dirty[2];
 
     uint64_t time;
-    int      render_time[4];
+    int      render_time[VOODOO_MAX_RENDER_THREADS];
     uint64_t fifo_full_waits;
     uint64_t fifo_full_wait_ticks;
     uint64_t fifo_full_spin_checks;
@@ -715,7 +741,7 @@ typedef struct voodoo_t {
     uint32_t launch_pending;
 
     uint8_t fifo_thread_run;
-    uint8_t render_thread_run[4];
+    uint8_t render_thread_run[VOODOO_MAX_RENDER_THREADS];
 
     uint8_t *vram;
     uint8_t *changedvram;
@@ -116,6 +116,19 @@ typedef struct dbcs_font_t {
     uint8_t chr[32];
 } dbcs_font_t;
 
+/* Text mode glyph rows expanded to 8 pixels, for every font byte and
+   every pair of 16-colour foreground and background indices. A pair is
+   built the first time it is drawn and dropped when the palette that
+   the indices resolve through changes. Keying on the font byte rather
+   than the character means font changes need no invalidation. The rows
+   are only touched as pairs are used, so the 2 MB are mostly never
+   committed. */
+typedef struct glyph_cache_t {
+    uint32_t pal[16];
+    uint32_t valid[8];
+    uint32_t rows[256][256 * 8];
+} glyph_cache_t;
+
 struct blit_data_struct;
 
 typedef struct monitor_t {
@@ -171,7 +184,7 @@ typedef struct monitor_settings_t {
 extern monitor_t          monitors[MONITORS_NUM];
 extern monitor_settings_t monitor_settings[MONITORS_NUM];
 extern atomic_bool        doresize_monitors[MONITORS_NUM];
-extern int                monitor_index_global;
+extern __thread int       monitor_index_global;
 extern int                show_second_monitors;
 extern int                video_fullscreen_scale_maximized;
 
@@ -278,14 +291,33 @@ extern void video_blit_memtoscreen_8(int x, int y, int w, int h);
 extern void video_blend_monitor(int x, int y, int monitor_index);
 extern void video_process_8_monitor(int x, int y, int monitor_index);
 extern void video_blit_memtoscreen_monitor(int x, int y, int w, int h, int monitor_index);
+extern void video_blit_set_dirty_monitor(int y1, int y2, int monitor_index);
+extern void video_blit_dirty_monitor(int monitor_index, int *y1, int *y2);
+extern bitmap_t *video_blit_frame_monitor(int monitor_index);
+extern bitmap_t *video_last_frame_monitor(int monitor_index, int *x, int *y, int *w, int *h, uint32_t *seq);
 extern void video_blit_complete_monitor(int monitor_index);
 extern void video_wait_for_blit_monitor(int monitor_index);
 extern void video_wait_for_buffer_monitor(int monitor_index);
+extern int  video_skip_frame(int monitor_index);
 
 extern bitmap_t *create_bitmap(int w, int h);
 extern void      destroy_bitmap(bitmap_t *b);
 extern void      cgapal_rebuild_monitor(int monitor_index);
 extern void      hline(bitmap_t *b, int x1, int y, int x2, uint32_t col);
+extern void      glyph_cache_set_palette(glyph_cache_t *gc, const uint32_t *pal);
+extern void      glyph_cache_build(glyph_cache_t *gc, int pair);
+
+/* The 8 pixels of font byte dat in colours fg and bg. */
+static inline const uint32_t *
+glyph_cache_row(glyph_cache_t *gc, int fg, int bg, uint8_t dat)
+{
+    const int pair = (fg << 4) | bg;
+
+    if (!(gc->valid[pair >> 5] & (1u << (pair & 31))))
+        glyph_cache_build(gc, pair);
+
+    return &gc->rows[pair][dat << 3];
+}
 extern void      updatewindowsize(int x, int y);
 
 extern void    video_monitor_init(int);
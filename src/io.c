@@ -41,11 +41,26 @@ typedef struct _io_ {
     void (*outw)(uint16_t addr, uint16_t val, void *priv);
     void (*outl)(uint16_t addr, uint32_t val, void *priv);
 
+    int (*inblock)(uint16_t addr, void *buf, int width, int count, void *priv);
+    int (*outblock)(uint16_t addr, const void *buf, int width, int count, void *priv);
+
     void *priv;
 
     struct _io_ *prev, *next;
 } io_t;
 
+/* Direct dispatch entry, valid for the access widths set in the masks. */
+typedef struct {
+    io_t   *in;
+    io_t   *out;
+    uint8_t in_mask;
+    uint8_t out_mask;
+} io_fast_t;
+
+#define IO_FAST_B 1
+#define IO_FAST_W 2
+#define IO_FAST_L 4
+
 typedef struct {
     uint8_t   enable;
     uint16_t  base;
@@ -58,6 +73,8 @@ int   initialized = 0;
 io_t *io[NPORTS];
 io_t *io_last[NPORTS];
 
+static io_fast_t io_fast[NPORTS];
+
 #ifdef ENABLE_IO_LOG
 int io_do_log = ENABLE_IO_LOG;
 
@@ -76,6 +93,106 @@ io_log(const char *fmt, ...)
 #    define io_log(fmt, ...)
 #endif
 
+static int
+io_has(io_t *p, int write, int width)
+{
+    switch (width) {
+        case IO_FAST_B:
+            return write ? (p->outb != NULL) : (p->inb != NULL);
+        case IO_FAST_W:
+            return write ? (p->outw != NULL) : (p->inw != NULL);
+        case IO_FAST_L:
+            return write ? (p->outl != NULL) : (p->inl != NULL);
+        default:
+            return 0;
+    }
+}
+
+/* Count the handlers at a port that have width have but none of the widths in lack. */
+static int
+io_count(uint16_t port, int write, int have, int lack, io_t **last)
+{
+    io_t *p = io[port];
+    int   n = 0;
+
+    while (p) {
+        if (io_has(p, write, have) && !((lack & IO_FAST_W) && io_has(p, write, IO_FAST_W)) &&
+            !((lack & IO_FAST_L) && io_has(p, write, IO_FAST_L))) {
+            if (last != NULL)
+                *last = p;
+            n++;
+        }
+        p = p->next;
+    }
+
+    return n;
+}
+
+/*
+ * An access can be dispatched directly when exactly one handler takes it at
+ * its native width and no narrower handler would be called to fill in the
+ * rest - inw(), inl() and friends AND or broadcast across all of them otherwise.
+ * By construction, the one handler is the same for every width that qualifies.
+ */
+static void
+io_fast_update(uint16_t port)
+{
+    io_fast_t *f = &io_fast[port];
+    io_t      *h;
+    io_t      *p;
+    uint8_t    mask;
+    int        ok;
+
+    for (int write = 0; write < 2; write++) {
+        h    = NULL;
+        mask = 0;
+
+        if (io_count(port, write, IO_FAST_B, 0, &p) == 1) {
+            h = p;
+            mask |= IO_FAST_B;
+        }
+
+        if ((io_count(port, write, IO_FAST_W, 0, &p) == 1) &&
+            !io_count(port, write, IO_FAST_B, IO_FAST_W, NULL) &&
+            !io_count((port + 1) & 0xffff, write, IO_FAST_B, IO_FAST_W, NULL)) {
+            h = p;
+            mask |= IO_FAST_W;
+        }
+
+        if ((io_count(port, write, IO_FAST_L, 0, &p) == 1) &&
+            !io_count(port, write, IO_FAST_W, IO_FAST_L, NULL) &&
+            !io_count((port + 2) & 0xffff, write, IO_FAST_W, IO_FAST_L, NULL)) {
+            ok = 1;
+            for (int i = 0; i < 4; i++) {
+                if (io_count((port + i) & 0xffff, write, IO_FAST_B, IO_FAST_W | IO_FAST_L, NULL)) {
+                    ok = 0;
+                    break;
+                }
+            }
+            if (ok) {
+                h = p;
+                mask |= IO_FAST_L;
+            }
+        }
+
+        if (write) {
+            f->out      = h;
+            f->out_mask = mask;
+        } else {
+            f->in      = h;
+            f->in_mask = mask;
+        }
+    }
+}
+
+/* Word and dword entries also depend on the three ports above them. */
+static void
+io_fast_rebuild(uint16_t base, int size)
+{
+    for (int c = -3; c < size; c++)
+        io_fast_update((base + c) & 0xffff);
+}
+
 void
 io_init(void)
 {
@@ -105,6 +222,8 @@ io_init(void)
         /* io[c] should be NULL. */
         io[c] = io_last[c] = NULL;
     }
+
+    memset(io_fast, 0x00, sizeof(io_fast));
 }
 
 void
@@ -147,6 +266,8 @@ io_sethandler_common(uint16_t base, int size,
 
         q = NULL;
     }
+
+    io_fast_rebuild(base, size);
 }
 
 void
@@ -184,6 +305,8 @@ io_removehandler_common(uint16_t base, int size,
             p = q;
         }
     }
+
+    io_fast_rebuild(base, size);
 }
 
 void
@@ -280,6 +403,27 @@ io_handler_interleaved(int set, uint16_t base, int size,
     io_handler_common(set, base, size, inb, inw, inl, outb, outw, outl, priv, 2);
 }
 
+/* Attach block transfer handlers to the handlers already set with this priv. */
+void
+io_set_block_handler(uint16_t base, int size,
+                     int (*inblock)(uint16_t addr, void *buf, int width, int count, void *priv),
+                     int (*outblock)(uint16_t addr, const void *buf, int width, int count, void *priv),
+                     void *priv)
+{
+    io_t *p;
+
+    for (int c = 0; c < size; c++) {
+        p = io[(base + c) & 0xffff];
+        while (p) {
+            if (p->priv == priv) {
+                p->inblock  = inblock;
+                p->outblock = outblock;
+            }
+            p = p->next;
+        }
+    }
+}
+
 #ifdef USE_DEBUG_REGS_486
 extern int trap;
 /* Set trap for I/O address breakpoints. */
@@ -360,6 +504,13 @@ inb(uint16_t port)
         found = 1;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].in_mask & IO_FAST_B) {
+        p     = io_fast[port].in;
+        ret   = p->inb(port, p->priv);
+        found = 1;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -427,6 +578,13 @@ outb(uint16_t port, uint8_t val)
         found = 1;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].out_mask & IO_FAST_B) {
+        p = io_fast[port].out;
+        p->outb(port, val, p->priv);
+        found = 1;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -485,6 +643,13 @@ inw(uint16_t port)
         found = 2;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].in_mask & IO_FAST_W) {
+        p     = io_fast[port].in;
+        ret   = p->inw(port, p->priv);
+        found = 2;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -564,6 +729,13 @@ outw(uint16_t port, uint16_t val)
         found = 2;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].out_mask & IO_FAST_W) {
+        p = io_fast[port].out;
+        p->outw(port, val, p->priv);
+        found = 2;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -638,6 +810,13 @@ inl(uint16_t port)
         found = 4;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].in_mask & IO_FAST_L) {
+        p     = io_fast[port].in;
+        ret   = p->inl(port, p->priv);
+        found = 4;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -749,6 +928,13 @@ outl(uint16_t port, uint32_t val)
         found = 4;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].out_mask & IO_FAST_L) {
+        p = io_fast[port].out;
+        p->outl(port, val, p->priv);
+        found = 4;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -913,3 +1099,53 @@ io_trap_remove(void *handle)
 
     free(trap);
 }
+
+/*
+ * Transfer up to count elements of the given width between buf and a port in
+ * one call, for REP INS/OUTS. Only used when the port has a single handler
+ * that provides a block handler; returns the number of elements the device
+ * actually moved, which may be 0, in which case the caller falls back to
+ * inb()/outb() and friends.
+ */
+int
+io_read_block(uint16_t port, void *buf, int width, int count)
+{
+    const io_t *p = io_fast[port].in;
+
+    if (!(io_fast[port].in_mask & width) || (p->inblock == NULL))
+        return 0;
+
+    if (((pci_flags & FLAG_CONFIG_IO_ON) && (port >= pci_base) && (port < (pci_base + pci_size))) ||
+        ((pci_flags & FLAG_CONFIG_DEV0_IO_ON) && (port >= 0xc000) && (port < 0xc100)) ||
+        (amstrad_latch & 0x80000000))
+        return 0;
+
+    io_port = port;
+
+    count = p->inblock(port, buf, width, count, p->priv);
+
+    io_log("[%04X:%08X] (%i) inblock(%04X, %i) = %i\n", CS, cpu_state.pc, in_smm, port, width, count);
+
+    return count;
+}
+
+int
+io_write_block(uint16_t port, const void *buf, int width, int count)
+{
+    const io_t *p = io_fast[port].out;
+
+    if (!(io_fast[port].out_mask & width) || (p->outblock == NULL))
+        return 0;
+
+    if (((pci_flags & FLAG_CONFIG_IO_ON) && (port >= pci_base) && (port < (pci_base + pci_size))) ||
+        ((pci_flags & FLAG_CONFIG_DEV0_IO_ON) && (port >= 0xc000) && (port < 0xc100)))
+        return 0;
+
+    io_port = port;
+
+    count = p->outblock(port, buf, width, count, p->priv);
+
+    io_log("[%04X:%08X] (%i) outblock(%04X, %i) = %i\n", CS, cpu_state.pc, in_smm, port, width, count);
+
+    return count;
+}
@@ -88,6 +88,8 @@ uintptr_t  old_rl2;
 uint8_t    uncached = 0;
 int        writelnext;
 int        writelookup[256];
+static uint8_t writelookup_direct[256];
+static int     writelookup_direct_num = 0;
 
 /* The lookup tables. */
 page_t *page_lookup[1048576] = { 0 };
@@ -167,6 +169,15 @@ mem_addr_is_ram(uint32_t addr)
            (mapping == &ram_mid_mapping2) || (mapping == &ram_remapped_mapping);
 }
 
+/* Forget which write lookup entries are direct device pages, for when
+   the whole write lookup table has just been emptied. */
+static void
+mem_clear_write_direct(void)
+{
+    memset(writelookup_direct, 0x00, sizeof(writelookup_direct));
+    writelookup_direct_num = 0;
+}
+
 void
 resetreadlookup(void)
 {
@@ -183,6 +194,7 @@ resetreadlookup(void)
     memset(readlookup2, 0xff, (1 << 20) * sizeof(uintptr_t));
 
     memset(writelookup2, 0xff, (1 << 20) * sizeof(uintptr_t));
+    mem_clear_write_direct();
 
     readlnext  = 0;
     writelnext = 0;
@@ -204,6 +216,7 @@ flushmmucache(void)
             writelookup[c]               = 0xffffffff;
         }
     }
+    mem_clear_write_direct();
     mmuflush++;
 
     pccache  = (uint32_t) 0xffffffff;
@@ -224,6 +237,7 @@ flushmmucache_write(void)
             writelookup[c]               = 0xffffffff;
         }
     }
+    mem_clear_write_direct();
     mmuflush++;
 }
 
@@ -254,6 +268,7 @@ flushmmucache_nopc(void)
             writelookup[c]               = 0xffffffff;
         }
     }
+    mem_clear_write_direct();
 }
 
 void
@@ -268,6 +283,10 @@ mem_flush_write_page(uint32_t addr, uint32_t virt)
                 writelookup2[writelookup[c]] = LOOKUP_INV;
                 page_lookup[writelookup[c]]  = NULL;
                 writelookup[c]               = 0xffffffff;
+                if (writelookup_direct[c]) {
+                    writelookup_direct[c] = 0;
+                    writelookup_direct_num--;
+                }
             }
         }
     }
@@ -624,12 +643,63 @@ addwritelookup(uint32_t virt, uint32_t phys)
         writelookup2[virt >> 12] = (uintptr_t) &ram[(uintptr_t) (phys & ~0xFFF) - (uintptr_t) (virt & ~0xfff)];
     }
 
-    writelookup[writelnext++] = virt >> 12;
+    if (writelookup_direct[writelnext])
+        writelookup_direct_num--;
+    writelookup_direct[writelnext] = 0;
+    writelookup[writelnext++]      = virt >> 12;
+    writelnext &= (cachesize - 1);
+
+    cycles -= 9;
+}
+
+/* Publish a host pointer to a 4K page of device memory that currently
+   behaves like plain RAM for writes (such as a packed-pixel linear frame
+   buffer), so the CPU can store to it directly. The device is responsible
+   for revoking it with mem_flush_write_direct() once the page needs its
+   write handler again, including for its own dirty tracking. */
+void
+addwritelookup_direct(uint32_t virt, uint8_t *ptr)
+{
+    if (virt == 0xffffffff)
+        return;
+
+    if (page_lookup[virt >> 12] || (writelookup2[virt >> 12] != (uintptr_t) LOOKUP_INV))
+        return;
+
+    if (writelookup[writelnext] != -1) {
+        page_lookup[writelookup[writelnext]]  = NULL;
+        writelookup2[writelookup[writelnext]] = LOOKUP_INV;
+    }
+
+    writelookup2[virt >> 12] = (uintptr_t) ptr - (uintptr_t) (virt & ~0xfff);
+
+    if (!writelookup_direct[writelnext])
+        writelookup_direct_num++;
+    writelookup_direct[writelnext] = 1;
+    writelookup[writelnext++]      = virt >> 12;
     writelnext &= (cachesize - 1);
 
     cycles -= 9;
 }
 
+/* Drop every direct device page published by addwritelookup_direct(). */
+void
+mem_flush_write_direct(void)
+{
+    if (!writelookup_direct_num)
+        return;
+
+    for (int c = 0; c < (int) (sizeof(writelookup_direct) / sizeof(writelookup_direct[0])); c++) {
+        if (writelookup_direct[c] && (writelookup[c] != -1)) {
+            page_lookup[writelookup[c]]  = NULL;
+            writelookup2[writelookup[c]] = LOOKUP_INV;
+            writelookup[c]               = -1;
+        }
+    }
+
+    mem_clear_write_direct();
+}
+
 uint8_t *
 getpccache(uint32_t a)
 {
@@ -1761,6 +1831,60 @@ mem_write_phys(void *src, uint32_t addr, int transfer_size)
     }
 }
 
+/*
+ * Read the part of len bytes at addr that lies within its 4K page in one go,
+ * if the bus mapping there is RAM or has a block handler. Returns the number
+ * of bytes read, 0 if the caller has to use mem_read_phys() instead.
+ */
+uint32_t
+mem_read_phys_block(void *dest, uint32_t addr, uint32_t len, int transfer_size)
+{
+    mem_mapping_t *map = read_mapping_bus[addr >> MEM_GRANULARITY_BITS];
+    uint32_t       n   = MEM_GRANULARITY_SIZE - (addr & MEM_GRANULARITY_MASK);
+
+    if (n > len)
+        n = len;
+    n &= ~(transfer_size - 1);
+
+    mem_logical_addr = 0xffffffff;
+
+    if ((map == NULL) || (n == 0))
+        return 0;
+
+    if (cpu_use_exec && map->exec && ((((addr - map->base) & map->mask) + n - 1) == ((addr + n - 1 - map->base) & map->mask))) {
+        memcpy(dest, &(map->exec[(addr - map->base) & map->mask]), n);
+        return n;
+    } else if (map->read_block)
+        return map->read_block(addr, dest, transfer_size, n / transfer_size, map->priv) * transfer_size;
+
+    return 0;
+}
+
+/* Write counterpart of mem_read_phys_block(). */
+uint32_t
+mem_write_phys_block(const void *src, uint32_t addr, uint32_t len, int transfer_size)
+{
+    mem_mapping_t *map = write_mapping_bus[addr >> MEM_GRANULARITY_BITS];
+    uint32_t       n   = MEM_GRANULARITY_SIZE - (addr & MEM_GRANULARITY_MASK);
+
+    if (n > len)
+        n = len;
+    n &= ~(transfer_size - 1);
+
+    mem_logical_addr = 0xffffffff;
+
+    if ((map == NULL) || (n == 0))
+        return 0;
+
+    if (cpu_use_exec && map->exec && ((((addr - map->base) & map->mask) + n - 1) == ((addr + n - 1 - map->base) & map->mask))) {
+        memcpy(&(map->exec[(addr - map->base) & map->mask]), src, n);
+        return n;
+    } else if (map->write_block)
+        return map->write_block(addr, src, transfer_size, n / transfer_size, map->priv) * transfer_size;
+
+    return 0;
+}
+
 uint8_t
 mem_read_ram(uint32_t addr, UNUSED(void *priv))
 {
@@ -2459,19 +2583,21 @@ mem_mapping_set(mem_mapping_t *map,
         map->enable = 1;
     else
         map->enable = 0;
-    map->base    = base;
-    map->size    = size;
-    map->mask    = (map->size ? 0xffffffff : 0x00000000);
-    map->read_b  = read_b;
-    map->read_w  = read_w;
-    map->read_l  = read_l;
-    map->write_b = write_b;
-    map->write_w = write_w;
-    map->write_l = write_l;
-    map->exec    = exec;
-    map->flags   = fl;
-    map->priv    = priv;
-    map->next    = NULL;
+    map->base        = base;
+    map->size        = size;
+    map->mask        = (map->size ? 0xffffffff : 0x00000000);
+    map->read_b      = read_b;
+    map->read_w      = read_w;
+    map->read_l      = read_l;
+    map->write_b     = write_b;
+    map->write_w     = write_w;
+    map->write_l     = write_l;
+    map->read_block  = NULL;
+    map->write_block = NULL;
+    map->exec        = exec;
+    map->flags       = fl;
+    map->priv        = priv;
+    map->next        = NULL;
     mem_log("mem_mapping_add(): Linked list structure: %08X -> %08X -> %08X\n", map->prev, map, map->next);
 
     /* If the mapping is disabled, there is no need to recalc anything. */
@@ -2547,9 +2673,22 @@ mem_mapping_set_handler(mem_mapping_t *map,
     map->write_w = write_w;
     map->write_l = write_l;
 
+    /* Block handlers go with the handler set they were registered for. */
+    map->read_block  = NULL;
+    map->write_block = NULL;
+
     mem_mapping_recalc(map->base, map->size);
 }
 
+void
+mem_mapping_set_block_handler(mem_mapping_t *map,
+                              uint32_t (*read_block)(uint32_t addr, void *buf, int width, uint32_t count, void *priv),
+                              uint32_t (*write_block)(uint32_t addr, const void *buf, int width, uint32_t count, void *priv))
+{
+    map->read_block  = read_block;
+    map->write_block = write_block;
+}
+
 void
 mem_mapping_set_write_handler(mem_mapping_t *map,
                               void (*write_b)(uint32_t addr, uint8_t val, void *priv),
@@ -2560,6 +2699,8 @@ mem_mapping_set_write_handler(mem_mapping_t *map,
     map->write_w = write_w;
     map->write_l = write_l;
 
+    map->write_block = NULL;
+
     mem_mapping_recalc(map->base, map->size);
 }
 
@@ -0,0 +1,192 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Deadline-based pacing of the emulation thread.
+ *
+ *          Periods are placed on a fixed grid of absolute deadlines, so
+ *          oversleeping in one period is made up in the following ones
+ *          instead of accumulating as drift. The thread sleeps until the
+ *          next deadline rather than polling in millisecond steps.
+ *
+ * Authors: agent, <agent@local>
+ *
+ *          Copyright 2025 agent.
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <wchar.h>
+#ifdef _WIN32
+#    include <windows.h>
+#endif
+#include <86box/plat.h>
+#include <86box/pace.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#    define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+/* Give up catching up once this far behind, like the old 50 ms limit. */
+#define PACE_CATCHUP_NS 50000000ULL
+
+static uint64_t pace_next;
+static uint64_t pace_period;
+static uint64_t pace_late[PACE_LATE_BUCKETS];
+static uint64_t pace_dropped;
+static uint64_t pace_last_late;
+
+static const uint64_t pace_late_limit[PACE_LATE_BUCKETS - 1] = {
+    100000ULL, 250000ULL, 500000ULL, 1000000ULL, 2000000ULL, 5000000ULL, 10000000ULL
+};
+
+#ifdef _WIN32
+static HANDLE pace_timer       = NULL;
+static int    pace_timer_tried = 0;
+#endif
+
+uint64_t
+pace_time_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq = { 0 };
+    LARGE_INTEGER        now;
+
+    if (!freq.QuadPart)
+        QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+
+    return ((uint64_t) (now.QuadPart / freq.QuadPart) * 1000000000ULL) +
+           (((uint64_t) (now.QuadPart % freq.QuadPart) * 1000000000ULL) / (uint64_t) freq.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+static void
+pace_record(uint64_t late)
+{
+    int i;
+
+    for (i = 0; i < (PACE_LATE_BUCKETS - 1); i++) {
+        if (late < pace_late_limit[i])
+            break;
+    }
+
+    pace_late[i]++;
+}
+
+void
+pace_reset(uint32_t period_ms)
+{
+    pace_period = (uint64_t) period_ms * 1000000ULL;
+    pace_next   = pace_time_ns() + pace_period;
+}
+
+/* Returns how many periods have come due since the last call. */
+int
+pace_due(uint32_t period_ms)
+{
+    uint64_t now;
+    uint64_t late;
+    uint64_t n;
+
+    if (((uint64_t) period_ms * 1000000ULL) != pace_period) {
+        pace_reset(period_ms);
+        return 0;
+    }
+
+    now = pace_time_ns();
+    if (now < pace_next)
+        return 0;
+
+    /* Paused periods run nothing, so they stay out of the statistics. */
+    late = now - pace_next;
+    if (late >= PACE_CATCHUP_NS) {
+        /* Too far behind (host overloaded, fast forward or a debugger
+           stop), start a new grid from now. */
+        if (!dopause)
+            pace_dropped++;
+        pace_last_late = late;
+        pace_next      = now + pace_period;
+        return 1;
+    }
+
+    if (!dopause)
+        pace_record(late);
+    pace_last_late = late;
+
+    n = (late / pace_period) + 1;
+    pace_next += n * pace_period;
+
+    return (int) n;
+}
+
+/* Sleeps until the next deadline. */
+void
+pace_wait(void)
+{
+    uint64_t now = pace_time_ns();
+#ifdef _WIN32
+    LARGE_INTEGER due;
+#else
+    struct timespec ts;
+#endif
+
+    if (now >= pace_next)
+        return;
+
+#ifdef _WIN32
+    /* Sleep() is only good to a millisecond at best, use a high resolution
+       waitable timer where the host has one. */
+    if (!pace_timer_tried) {
+        pace_timer       = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        pace_timer_tried = 1;
+    }
+
+    due.QuadPart = -((LONGLONG) ((pace_next - now) / 100ULL));
+    if ((pace_timer != NULL) && SetWaitableTimer(pace_timer, &due, 0, NULL, NULL, FALSE))
+        WaitForSingleObject(pace_timer, INFINITE);
+    else
+        Sleep(1);
+#elif defined(__APPLE__)
+    /* No clock_nanosleep() here, sleep for the remainder instead. */
+    ts.tv_sec  = (time_t) ((pace_next - now) / 1000000000ULL);
+    ts.tv_nsec = (long) ((pace_next - now) % 1000000000ULL);
+    nanosleep(&ts, NULL);
+#else
+    ts.tv_sec  = (time_t) (pace_next / 1000000000ULL);
+    ts.tv_nsec = (long) (pace_next % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+#endif
+}
+
+/* Returns whether the host fell behind by more than a period when the
+   last due periods were picked up. */
+int
+pace_behind(void)
+{
+    return pace_last_late > pace_period;
+}
+
+/* Copies the lateness histogram of the periods run so far, see
+   PACE_LATE_BUCKETS, and the number of times pacing gave up catching up. */
+void
+pace_get_lateness(uint64_t *buckets, uint64_t *dropped)
+{
+    if (buckets != NULL)
+        memcpy(buckets, pace_late, sizeof(pace_late));
+
+    if (dropped != NULL)
+        *dropped = pace_dropped;
+}
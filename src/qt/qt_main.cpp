@@ -47,6 +47,7 @@ extern "C" {
 #include <86box/86box.h>
 #include <86box/config.h>
 #include <86box/plat.h>
+#include <86box/pace.h>
 #include <86box/ui.h>
 #include <86box/video.h>
 #ifdef DISCORD
@@ -440,21 +441,20 @@ main_thread_fn()
 
     QThread::currentThread()->setPriority(QThread::HighestPriority);
     plat_set_thread_name(nullptr, "main_thread");
+    pc_thread_setup(THREAD_ROLE_EMU);
     framecountx = 0;
     // title_update = 1;
-    uint64_t old_time = elapsed_timer.elapsed();
-    int      drawits = frames = 0;
-    is_cpu_thread             = 1;
+    int drawits = frames = 0;
+    is_cpu_thread        = 1;
+    pace_reset(force_10ms ? 10 : 1);
     while (!is_quit && cpu_thread_run) {
         /* See if it is time to run a frame of code. */
-        const uint64_t new_time = elapsed_timer.elapsed();
 #ifdef USE_GDBSTUB
         if (gdbstub_next_asap && (drawits <= 0))
-            drawits = force_10ms ? 10 : 1;
+            drawits = 1;
         else
 #endif
-            drawits += static_cast<int>(new_time - old_time);
-        old_time = new_time;
+            drawits += pace_due(force_10ms ? 10 : 1) * speed_mult;
         if ((drawits > 0 || fast_forward) && !dopause) {
             /* Yes, so run frames now. */
             do {
@@ -479,9 +479,9 @@ main_thread_fn()
                     nvr_dosave = 0;
                     frames     = 0;
                 }
-                
-                drawits -= force_10ms ? 10 : 1;
-                if (drawits > 50 || fast_forward)
+
+                drawits--;
+                if ((drawits > (50 * speed_mult)) || fast_forward)
                     drawits = 0;
 
             } while (drawits > 0);
@@ -495,10 +495,13 @@ main_thread_fn()
                 pc_reset_hard_init();
             }
 
-            if (dopause)
+            if (dopause) {
                 ack_pause();
+                drawits = 0;
+            }
 
-            plat_delay_ms(1);
+            /* Sleep until the next period is due. */
+            pace_wait();
         }
     }
 
@@ -1592,6 +1592,11 @@ MainWindow::eventFilter(QObject *receiver, QEvent *event)
                 || (QKeySequence) (ke->key() | ke->modifiers()) == FindAcceleratorSeq("fast_forward")) {
                 ui->actionFast_forward->trigger();
             }
+            if ((QKeySequence) (ke->key() | (ke->modifiers() & ~Qt::KeypadModifier)) == FindAcceleratorSeq("cycle_speed")
+                || (QKeySequence) (ke->key() | ke->modifiers()) == FindAcceleratorSeq("cycle_speed")) {
+                pc_cycle_speed();
+                config_save();
+            }
             if ((QKeySequence) (ke->key() | (ke->modifiers() & ~Qt::KeypadModifier)) == FindAcceleratorSeq("send_ctrl_alt_del")
                 || (QKeySequence) (ke->key() | ke->modifiers()) == FindAcceleratorSeq("send_ctrl_alt_del")) {
                 ui->actionCtrl_Alt_Del->trigger();
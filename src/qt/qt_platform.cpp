@@ -20,7 +20,10 @@
 #    include <OS.h>
 #endif
 
+#include <cerrno>
+#include <cinttypes>
 #include <cstdio>
+#include <cstring>
 
 #include <mutex>
 #include <thread>
@@ -69,6 +72,16 @@
 #ifdef Q_OS_OPENBSD
 #    include <pthread_np.h>
 #endif
+#ifdef Q_OS_FREEBSD
+#    include <pthread_np.h>
+#    include <sys/cpuset.h>
+#endif
+#ifdef Q_OS_LINUX
+#    include <sched.h>
+#    include <sys/resource.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
 
 #if 0
 static QByteArray buf;
@@ -982,6 +995,67 @@ plat_set_thread_name(void *thread, const char *name)
 #endif
 }
 
+void
+plat_set_thread_affinity(uint64_t mask)
+{
+#ifdef Q_OS_WINDOWS
+    if (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) mask) == 0)
+        pclog("Could not set thread affinity to %016" PRIX64 ": error %lu\n", mask, GetLastError());
+#elif defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD)
+#    ifdef Q_OS_FREEBSD
+    cpuset_t set;
+#    else
+    cpu_set_t set;
+#    endif
+
+    CPU_ZERO(&set);
+    for (int i = 0; i < 64; i++) {
+        if (mask & (1ULL << i))
+            CPU_SET(i, &set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (ret != 0)
+        pclog("Could not set thread affinity to %016" PRIX64 ": %s (%i)\n", mask, strerror(ret), ret);
+#else
+    /* No hard CPU affinity on this host. */
+    (void) mask;
+#endif
+}
+
+/* Raises the scheduling priority of the calling thread. Windows uses the
+   highest or time critical thread priority. Elsewhere level 2 tries
+   SCHED_FIFO and Linux falls back to nice -10, which is below the default
+   of 0, i.e. a higher priority. Linux only allows either with root or
+   CAP_SYS_NICE; otherwise the calls fail, the failure is logged and nothing
+   changes. */
+void
+plat_set_thread_priority(int level)
+{
+#ifdef Q_OS_WINDOWS
+    if (!SetThreadPriority(GetCurrentThread(), (level >= 2) ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST))
+        pclog("Could not raise thread priority: error %lu\n", GetLastError());
+#elif defined(Q_OS_UNIX)
+    if (level >= 2) {
+        struct sched_param param = {};
+        int                ret;
+
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        ret                  = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret == 0)
+            return;
+        /* Not permitted, fall back to nice -10. */
+        pclog("Could not switch thread to SCHED_FIFO: %s (%i), trying nice -10\n", strerror(ret), ret);
+    }
+#    ifdef Q_OS_LINUX
+    /* Linux nice values are per thread. */
+    if (setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), -10) != 0)
+        pclog("Could not set thread nice value to -10: %s (%i)\n", strerror(errno), errno);
+#    else
+    (void) level;
+#    endif
+#endif
+}
+
 void
 plat_break(void)
 {
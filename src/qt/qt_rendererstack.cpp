@@ -511,9 +511,10 @@ RendererStack::blit(int x, int y, int w, int h)
     sw = this->w = w;
     sh = this->h       = h;
     uint8_t *imagebits = std::get<uint8_t *>(imagebufs[currentBuf]);
+    bitmap_t *frame    = video_blit_frame_monitor(m_monitor_index);
     for (int y1 = y; y1 < (y + h); y1++) {
         auto scanline = imagebits + (y1 * rendererWindow->getBytesPerRow()) + (x * 4);
-        video_copy(scanline, &(monitors[m_monitor_index].target_buffer->line[y1][x]), w * 4);
+        video_copy(scanline, &(frame->line[y1][x]), w * 4);
     }
 
     if (monitors[m_monitor_index].mon_screenshots_raw) {
@@ -36,6 +36,7 @@
 #include <86box/timer.h>
 #include <86box/snd_mpu401.h>
 #include <86box/sound.h>
+#include <86box/capture.h>
 #include <86box/fdd_audio.h>
 #include <86box/hdd_audio.h>
 
@@ -103,6 +104,14 @@ static event_t      *sound_hdd_start_event;
 static volatile int hddaudioon = 0;
 static int          hdd_thread_enable = 0;
 
+/* Position of each output in its speed multiplier decimation cycle. */
+static int sound_mult_phase     = 0;
+static int music_mult_phase     = 0;
+static int wavetable_mult_phase = 0;
+static int cd_mult_phase        = 0;
+static int fdd_mult_phase       = 0;
+static int hdd_mult_phase       = 0;
+
 static void (*filter_cd_audio)(int channel, double *buffer, void *priv) = NULL;
 static void *filter_cd_audio_p                                          = NULL;
 
@@ -294,6 +303,22 @@ sound_cd_clean_buffers(void)
         memset(cd_out_buffer_int16, 0, (CD_BUFLEN * 2) * sizeof(int16_t));
 }
 
+/* Above real time only every speed_mult'th buffer goes to the host, so
+   audio output keeps its real-time rate. */
+static int
+sound_mult_drop(int *phase)
+{
+    if (speed_mult <= 1) {
+        *phase = 0;
+        return 0;
+    }
+
+    if (++(*phase) >= speed_mult)
+        *phase = 0;
+
+    return !!*phase;
+}
+
 static void
 sound_cd_thread(UNUSED(void *param))
 {
@@ -303,6 +328,7 @@ sound_cd_thread(UNUSED(void *param))
     double   audio_vol_r;
     double   cd_buffer_temp[2] = { 0.0, 0.0 };
 
+    pc_thread_setup(THREAD_ROLE_SOUND);
     thread_set_event(sound_cd_start_event);
 
     while (cdaudioon) {
@@ -404,10 +430,12 @@ sound_cd_thread(UNUSED(void *param))
             }
         }
 
-        if (sound_is_float)
-            givealbuffer_cd(cd_out_buffer);
-        else
-            givealbuffer_cd(cd_out_buffer_int16);
+        if (!sound_mult_drop(&cd_mult_phase)) {
+            if (sound_is_float)
+                givealbuffer_cd(cd_out_buffer);
+            else
+                givealbuffer_cd(cd_out_buffer_int16);
+        }
     }
 }
 
@@ -610,10 +638,14 @@ sound_poll(UNUSED(void *priv))
             }
         }
 
-        if (sound_is_float)
-            givealbuffer(outbuffer_ex);
-        else
-            givealbuffer(outbuffer_ex_int16);
+        capture_poll(outbuffer, SOUNDBUFLEN);
+
+        if (!sound_mult_drop(&sound_mult_phase)) {
+            if (sound_is_float)
+                givealbuffer(outbuffer_ex);
+            else
+                givealbuffer(outbuffer_ex_int16);
+        }
 
         if (cd_thread_enable) {
             cd_buf_update--;
@@ -661,10 +693,12 @@ music_poll(UNUSED(void *priv))
             }
         }
 
-        if (sound_is_float)
-            givealbuffer_music(outbuffer_m_ex);
-        else
-            givealbuffer_music(outbuffer_m_ex_int16);
+        if (!sound_mult_drop(&music_mult_phase)) {
+            if (sound_is_float)
+                givealbuffer_music(outbuffer_m_ex);
+            else
+                givealbuffer_music(outbuffer_m_ex_int16);
+        }
 
         music_pos_global = 0;
     }
@@ -697,10 +731,12 @@ wavetable_poll(UNUSED(void *priv))
             }
         }
 
-        if (sound_is_float)
-            givealbuffer_wt(outbuffer_w_ex);
-        else
-            givealbuffer_wt(outbuffer_w_ex_int16);
+        if (!sound_mult_drop(&wavetable_mult_phase)) {
+            if (sound_is_float)
+                givealbuffer_wt(outbuffer_w_ex);
+            else
+                givealbuffer_wt(outbuffer_w_ex_int16);
+        }
 
         wavetable_pos_global = 0;
     }
@@ -819,6 +855,7 @@ sound_cd_thread_reset(void)
 static void
 sound_fdd_thread(UNUSED(void *param))
 {
+    pc_thread_setup(THREAD_ROLE_SOUND);
     thread_set_event(sound_fdd_start_event);
     while (fddaudioon) {
         thread_wait_event(sound_fdd_event, -1);
@@ -830,7 +867,8 @@ sound_fdd_thread(UNUSED(void *param))
         static float fdd_float_buffer[SOUNDBUFLEN * 2];
         memset(fdd_float_buffer, 0, sizeof(fdd_float_buffer));
         fdd_audio_callback((int16_t*)fdd_float_buffer, SOUNDBUFLEN * 2);
-        givealbuffer_fdd(fdd_float_buffer, SOUNDBUFLEN * 2);
+        if (!sound_mult_drop(&fdd_mult_phase))
+            givealbuffer_fdd(fdd_float_buffer, SOUNDBUFLEN * 2);
     }
 }
 
@@ -877,6 +915,7 @@ sound_fdd_thread_end(void)
 static void
 sound_hdd_thread(UNUSED(void *param))
 {
+    pc_thread_setup(THREAD_ROLE_SOUND);
     thread_set_event(sound_hdd_start_event);
     while (hddaudioon) {
         thread_wait_event(sound_hdd_event, -1);
@@ -888,7 +927,8 @@ sound_hdd_thread(UNUSED(void *param))
         static float hdd_float_buffer[SOUNDBUFLEN * 2];
         memset(hdd_float_buffer, 0, sizeof(hdd_float_buffer));
         hdd_audio_callback((int16_t*)hdd_float_buffer, SOUNDBUFLEN * 2);
-        givealbuffer_hdd(hdd_float_buffer, SOUNDBUFLEN * 2);
+        if (!sound_mult_drop(&hdd_mult_phase))
+            givealbuffer_hdd(hdd_float_buffer, SOUNDBUFLEN * 2);
     }
 }
 
@@ -1,6 +1,7 @@
 #ifdef __linux__
 #    define _FILE_OFFSET_BITS   64
 #    define _LARGEFILE64_SOURCE 1
+#    define _GNU_SOURCE         1 /* CPU_SET() and pthread_setaffinity_np() */
 #endif
 #ifdef __HAIKU__
 #include <OS.h>
@@ -36,6 +37,7 @@
 #include <86box/config.h>
 #include <86box/path.h>
 #include <86box/plat.h>
+#include <86box/pace.h>
 #include <86box/plat_dynld.h>
 #include <86box/thread.h>
 #include <86box/device.h>
@@ -52,6 +54,15 @@
 
 #define __USE_GNU 1 /* shouldn't be done, yet it is */
 #include <pthread.h>
+#include <sched.h>
+#ifdef __linux__
+#    include <sys/resource.h>
+#    include <sys/syscall.h>
+#endif
+#ifdef __FreeBSD__
+#    include <pthread_np.h>
+#    include <sys/cpuset.h>
+#endif
 
 extern SDL_Window         *sdl_win;
 
@@ -572,35 +583,31 @@ volatile int cpu_thread_run = 1;
 void
 main_thread(UNUSED(void *param))
 {
-    uint32_t old_time;
-    uint32_t new_time;
-    int      drawits;
-    int      frames;
+    int drawits;
+    int frames;
 
     SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+    pc_thread_setup(THREAD_ROLE_EMU);
     framecountx = 0;
     // title_update = 1;
-    old_time = SDL_GetTicks();
     drawits = frames = 0;
+    pace_reset(force_10ms ? 10 : 1);
     while (!is_quit && cpu_thread_run)
     {
         /* See if it is time to run a frame of code. */
-        new_time = SDL_GetTicks();
-
 #ifdef USE_GDBSTUB
         if (gdbstub_next_asap && (drawits <= 0))
-            drawits = 10;
+            drawits = 1;
         else
-            drawits += (new_time - old_time);
+            drawits += pace_due(force_10ms ? 10 : 1) * speed_mult;
 #else
-        drawits += (new_time - old_time);
+        drawits += pace_due(force_10ms ? 10 : 1) * speed_mult;
 #endif
 
-        old_time = new_time;
         if ((drawits > 0 || fast_forward) && !dopause) {
             /* Yes, so do one frame now. */
-            drawits -= force_10ms ? 10 : 1;
-            if (drawits > 50 || fast_forward)
+            drawits--;
+            if ((drawits > (50 * speed_mult)) || fast_forward)
                 drawits = 0;
 
             /* Run a block of code. */
@@ -612,9 +619,13 @@ main_thread(UNUSED(void *param))
                 nvr_dosave = 0;
                 frames     = 0;
             }
+        } else {
+            if (dopause)
+                drawits = 0;
+
+            /* Just so we dont overload the host OS. */
+            pace_wait();
         }
-        else /* Just so we dont overload the host OS. */
-            SDL_Delay(1);
 
         /* If needed, handle a screen resize. */
         if (atomic_load(&doresize_monitors[0]) && !video_fullscreen && !is_quit) {
@@ -1106,6 +1117,7 @@ unix_executeLine(char *line)
                 "hardreset - hard reset the emulated system.\n"
                 "pause - pause the the emulated system.\n"
                 "fastfwd - toggle fast forward.\n"
+                "speed [multiplier] - set (1 to 8) or cycle the guest speed multiplier.\n"
                 "screenshot - save a screenshot.\n"
                 "fullscreen - toggle fullscreen.\n"
                 "version - print version and license information.\n"
@@ -1158,6 +1170,16 @@ unix_executeLine(char *line)
         } else if (strncasecmp(xargv[0], "fastfwd", 7) == 0) {
             fast_forward ^= 1;
             printf("%s", fast_forward ? "Fast forward on.\n" : "Fast forward off.\n");
+        } else if (strncasecmp(xargv[0], "speed", 5) == 0) {
+            if (cmdargc >= 2 && xargv[1]) {
+                speed_mult = atoi(xargv[1]);
+                if (speed_mult < 1)
+                    speed_mult = 1;
+                else if (speed_mult > SPEED_MULT_MAX)
+                    speed_mult = SPEED_MULT_MAX;
+            } else
+                pc_cycle_speed();
+            printf("Speed multiplier: %dx.\n", speed_mult);
         } else if (strncasecmp(xargv[0], "hardreset", 9) == 0) {
             pc_reset_hard();
         } else if (strncasecmp(xargv[0], "cdload", 6) == 0 && cmdargc >= 3) {
@@ -1689,6 +1711,57 @@ plat_set_thread_name(void *thread, const char *name)
 #endif
 }
 
+void
+plat_set_thread_affinity(uint64_t mask)
+{
+#if defined(__linux__) || defined(__FreeBSD__)
+#    ifdef __FreeBSD__
+    cpuset_t set;
+#    else
+    cpu_set_t set;
+#    endif
+
+    CPU_ZERO(&set);
+    for (int i = 0; i < 64; i++) {
+        if (mask & (1ULL << i))
+            CPU_SET(i, &set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (ret != 0)
+        pclog("Could not set thread affinity to %016" PRIX64 ": %s (%i)\n", mask, strerror(ret), ret);
+#else
+    /* No hard CPU affinity on this host. */
+    (void) mask;
+#endif
+}
+
+/* Raises the scheduling priority of the calling thread: level 1 sets nice
+   -10, a lower nice value than the default 0 and so a higher priority, and
+   level 2 asks for SCHED_FIFO first. On Linux both need root or
+   CAP_SYS_NICE (or a large enough RLIMIT_RTPRIO/RLIMIT_NICE); without it
+   the calls fail, the failure is logged and the thread keeps its normal
+   priority. */
+void
+plat_set_thread_priority(int level)
+{
+    if (level >= 2) {
+        struct sched_param param = { 0 };
+        int                ret;
+
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        ret                  = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret == 0)
+            return;
+        /* Not permitted, fall back to nice -10. */
+        pclog("Could not switch thread to SCHED_FIFO: %s (%i), trying nice -10\n", strerror(ret), ret);
+    }
+#ifdef __linux__
+    /* Linux nice values are per thread. */
+    if (setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), -10) != 0)
+        pclog("Could not set thread nice value to -10: %s (%i)\n", strerror(errno), errno);
+#endif
+}
+
 /* Converts the numeric language ID to a language code string */
 void
 plat_language_code_r(UNUSED(int id), UNUSED(char *outbuf), UNUSED(int len))
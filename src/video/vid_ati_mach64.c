@@ -1887,6 +1887,99 @@ mach64_start_line(mach64_t *mach64)
         svga->changedvram[(((addr) >> 3) & mach64->vram_mask) >> 12] = svga->monitor->mon_changeframecount; \
     }
 
+/*First pixel and length of one axis of a rectangle, if it neither wraps
+  its coordinate range nor leaves [lo, hi].*/
+static int
+mach64_blit_span(int start, int inc, int len, int range, int lo, int hi, int *first)
+{
+    *first = (inc > 0) ? start : (start - len + 1);
+
+    return (*first >= 0) && ((*first + len - 1) <= range) && (*first >= lo) && ((*first + len - 1) <= hi);
+}
+
+/*Rectangle with a solid foreground colour or a plain screen to screen copy
+  as its only source, written straight through and entirely inside the
+  scissors: do it a row at a time. Returns 0 to leave it to the pixel loop.*/
+static int
+mach64_blit_rect_bulk(mach64_t *mach64)
+{
+    svga_t  *svga   = &mach64->svga;
+    int      w      = mach64->accel.dst_width;
+    int      h      = mach64->accel.dst_height;
+    int      size   = mach64->accel.dst_size;
+    int      copy   = (mach64->accel.source_fg == SRC_BLITSRC);
+    uint32_t pix_mask;
+    int      dst_x;
+    int      dst_y;
+    int      src_x = 0;
+    int      src_y = 0;
+
+    if ((mach64->accel.dst_x != 0) || (mach64->accel.dst_y != 0) || (w <= 0) || (h <= 0) || (size > 2) ||
+        mach64->accel.source_host || (mach64->accel.source_mix != MONO_SRC_1) || (mach64->accel.mix_fg != 0x7) ||
+        (mach64->accel.clr_cmp_fn == 1) || (mach64->accel.clr_cmp_fn == 4) || (mach64->accel.clr_cmp_fn == 5) ||
+        (mach64->dst_cntl & (DST_POLYGON_EN | DST_24_ROT_EN)))
+        return 0;
+
+    pix_mask = (size == 2) ? 0xffffffff : ((size == 1) ? 0xffff : 0xff);
+    if ((mach64->accel.write_mask & pix_mask) != pix_mask)
+        return 0;
+
+    if (!mach64_blit_span(mach64->accel.dst_x_start, mach64->accel.xinc, w, 0xfff, mach64->accel.sc_left, mach64->accel.sc_right, &dst_x) ||
+        !mach64_blit_span(mach64->accel.dst_y_start, mach64->accel.yinc, h, 0x3fff, mach64->accel.sc_top, mach64->accel.sc_bottom, &dst_y))
+        return 0;
+
+    if (copy) {
+        if ((mach64->accel.src_size != size) || (mach64->src_cntl & (SRC_PATT_EN | SRC_LINEAR_EN | SRC_8x8x8_BRUSH)) ||
+            (mach64->accel.src_width1 < w))
+            return 0;
+        if (!mach64_blit_span(mach64->accel.src_x_start, mach64->accel.xinc, w, 0xfff, 0, 0xfff, &src_x) ||
+            !mach64_blit_span(mach64->accel.src_y_start, mach64->accel.yinc, h, 0x3fff, 0, 0x3fff, &src_y))
+            return 0;
+    } else if (mach64->accel.source_fg != SRC_FG)
+        return 0;
+
+    for (int y = 0; y < h; y++) {
+        uint32_t dst = ((mach64->accel.dst_offset + ((dst_y + y) * mach64->accel.dst_pitch) + dst_x) << size) & mach64->vram_mask;
+        uint32_t src = ((mach64->accel.src_offset + ((src_y + y) * mach64->accel.src_pitch) + src_x) << size) & mach64->vram_mask;
+
+        if (((dst + (w << size)) > (mach64->vram_mask + 1)) || (copy && ((src + (w << size)) > (mach64->vram_mask + 1))))
+            return 0;
+    }
+
+    for (int c = 0; c < h; c++) {
+        /*Rows go in the blit's own vertical direction, in case source and
+          destination overlap.*/
+        int      y   = (mach64->accel.yinc > 0) ? c : (h - 1 - c);
+        uint32_t dst = ((mach64->accel.dst_offset + ((dst_y + y) * mach64->accel.dst_pitch) + dst_x) << size) & mach64->vram_mask;
+        uint32_t src = ((mach64->accel.src_offset + ((src_y + y) * mach64->accel.src_pitch) + src_x) << size) & mach64->vram_mask;
+
+        if (copy)
+            svga_blit_copy(svga, dst, src, w << size, mach64->accel.xinc < 0);
+        else
+            svga_blit_fill(svga, dst, mach64->accel.dp_frgd_clr & pix_mask, 1 << size, w);
+    }
+
+    mach64->accel.x_count     = w;
+    mach64->accel.xx_count    = 0;
+    mach64->accel.dst_y       = h * mach64->accel.yinc;
+    mach64->accel.src_x_start = (mach64->src_y_x >> 16) & 0xfff;
+    mach64->accel.src_x_count = mach64->accel.src_width1;
+    mach64->accel.src_x       = 0;
+    mach64->accel.src_y       = h * mach64->accel.yinc;
+    mach64->accel.src_y_count -= h;
+    mach64->accel.poly_draw   = 0;
+    mach64->accel.dst_height  = 0;
+
+    mach64_log("mach64 blit finished\n");
+    mach64->accel.busy = 0;
+    if (mach64->dst_cntl & DST_X_TILE)
+        mach64->dst_y_x = (mach64->dst_y_x & 0xfff) | ((mach64->dst_y_x + (mach64->accel.dst_width << 16)) & 0xfff0000);
+    if (mach64->dst_cntl & DST_Y_TILE)
+        mach64->dst_y_x = (mach64->dst_y_x & 0xfff0000) | ((mach64->dst_y_x + (mach64->dst_height_width & 0x1fff)) & 0xfff);
+
+    return 1;
+}
+
 void
 mach64_blit(uint32_t cpu_dat, int count, mach64_t *mach64)
 {
@@ -1901,6 +1994,9 @@ mach64_blit(uint32_t cpu_dat, int count, mach64_t *mach64)
 
     switch (mach64->accel.op) {
         case OP_RECT:
+            if ((count == -1) && mach64_blit_rect_bulk(mach64))
+                return;
+
             while (count) {
                 uint8_t  write_mask = 0;
                 uint32_t src_dat = 0;
@@ -4584,76 +4680,16 @@ mach64_int_hwcursor_draw(svga_t *svga, int displine)
         }                                                            \
     } while (0)
 
-#define DECODE_VYUY422()                                                 \
-    do {                                                                 \
-        for (x = 0; x < src_w; x += 1) {                                 \
-            uint8_t y1, y2;                                              \
-            int8_t  u, v;                                                \
-            int     dR, dG, dB;                                          \
-            int     r, g, b;                                             \
-                                                                         \
-            y1 = src[0];                                                 \
-            u  = src[1] - 0x80;                                          \
-            y2 = src[2];                                                 \
-            v  = src[3] - 0x80;                                          \
-            src += 4;                                                    \
-                                                                         \
-            dR = (359 * v) >> 8;                                         \
-            dG = (88 * u + 183 * v) >> 8;                                \
-            dB = (453 * u) >> 8;                                         \
-                                                                         \
-            r = y1 + dR;                                                 \
-            CLAMP(r);                                                    \
-            g = y1 - dG;                                                 \
-            CLAMP(g);                                                    \
-            b = y1 + dB;                                                 \
-            CLAMP(b);                                                    \
-            mach64->overlay_dat[x * 2] = (r << 16) | (g << 8) | b;       \
-                                                                         \
-            r = y2 + dR;                                                 \
-            CLAMP(r);                                                    \
-            g = y2 - dG;                                                 \
-            CLAMP(g);                                                    \
-            b = y2 + dB;                                                 \
-            CLAMP(b);                                                    \
-            mach64->overlay_dat[(x * 2) + 1] = (r << 16) | (g << 8) | b; \
-        }                                                                \
+#define DECODE_VYUY422()                                               \
+    do {                                                               \
+        svga_line_yuv422to32(mach64->overlay_dat, src, 0, src_w << 1); \
+        src += src_w << 2;                                             \
     } while (0)
 
-#define DECODE_YVYU422()                                                 \
-    do {                                                                 \
-        for (x = 0; x < src_w; x += 1) {                                 \
-            uint8_t y1, y2;                                              \
-            int8_t  u, v;                                                \
-            int     dR, dG, dB;                                          \
-            int     r, g, b;                                             \
-                                                                         \
-            u  = src[0] - 0x80;                                          \
-            y1 = src[1];                                                 \
-            v  = src[2] - 0x80;                                          \
-            y2 = src[3];                                                 \
-            src += 4;                                                    \
-                                                                         \
-            dR = (359 * v) >> 8;                                         \
-            dG = (88 * u + 183 * v) >> 8;                                \
-            dB = (453 * u) >> 8;                                         \
-                                                                         \
-            r = y1 + dR;                                                 \
-            CLAMP(r);                                                    \
-            g = y1 - dG;                                                 \
-            CLAMP(g);                                                    \
-            b = y1 + dB;                                                 \
-            CLAMP(b);                                                    \
-            mach64->overlay_dat[x * 2] = (r << 16) | (g << 8) | b;       \
-                                                                         \
-            r = y2 + dR;                                                 \
-            CLAMP(r);                                                    \
-            g = y2 - dG;                                                 \
-            CLAMP(g);                                                    \
-            b = y2 + dB;                                                 \
-            CLAMP(b);                                                    \
-            mach64->overlay_dat[(x * 2) + 1] = (r << 16) | (g << 8) | b; \
-        }                                                                \
+#define DECODE_YVYU422()                                                            \
+    do {                                                                            \
+        svga_line_yuv422to32(mach64->overlay_dat, src, SVGA_YUV_Y_ODD, src_w << 1); \
+        src += src_w << 2;                                                          \
     } while (0)
 
 #define DECODE_YUV12_PACKED()                                            \
@@ -839,14 +839,17 @@ bochs_vbe_init(const device_t *info)
 
     mem_mapping_add(&dev->linear_mapping, 0, 0,
                     svga_readb_linear, svga_readw_linear, svga_readl_linear,
-                    svga_writeb_linear, svga_writew_linear, svga_writel_linear,
+                    svga_writeb_lfb, svga_writew_lfb, svga_writel_lfb,
                     NULL, MEM_MAPPING_EXTERNAL, &dev->svga);
+    mem_mapping_set_block_handler(&dev->linear_mapping, svga_read_block_linear, svga_write_block_linear);
     /* Hack: If the mapping gets mapped anywhere other than at 0xe0000000,
              enable this second copy of it at 0xe0000000 so michaln's driver works. */
     mem_mapping_add(&dev->linear_mapping_2, 0, 0,
                     svga_readb_linear, svga_readw_linear, svga_readl_linear,
-                    svga_writeb_linear, svga_writew_linear, svga_writel_linear,
+                    svga_writeb_lfb, svga_writew_lfb, svga_writel_lfb,
                     NULL, MEM_MAPPING_EXTERNAL, &dev->svga);
+    mem_mapping_set_block_handler(&dev->linear_mapping_2, svga_read_block_linear, svga_write_block_linear);
+    dev->svga.direct_lfb = 1;
 
     mem_mapping_disable(&dev->bios_rom.mapping);
 
@@ -66,6 +66,10 @@ static uint8_t crtcmask[32] = {
 
 static uint8_t interp_lut[2][256][256];
 
+/* Text is drawn in palette indices 16 to 31, so one cache serves every
+   CGA and never needs invalidating. */
+static glyph_cache_t cga_glyph_cache;
+
 static video_timings_t timing_cga = { .type = VIDEO_ISA, .write_b = 8, .write_w = 16, .write_l = 32, .read_b = 8, .read_w = 16, .read_l = 32 };
 
 void cga_recalctimings(cga_t *cga);
@@ -254,6 +258,16 @@ cga_recalctimings(cga_t *cga)
     cga->dispofftime = (uint64_t) (_dispofftime);
 }
 
+static void
+cga_glyph_cache_init(void)
+{
+    uint32_t pal[16];
+
+    for (int c = 0; c < 16; c++)
+        pal[c] = c + 16;
+    glyph_cache_set_palette(&cga_glyph_cache, pal);
+}
+
 static void
 cga_render(cga_t *cga, int line)
 {
@@ -266,6 +280,8 @@ cga_render(cga_t *cga, int line)
     uint16_t dat;
     int      cols[4];
     int      col;
+    int      inv;
+    const uint32_t *row;
 
     int32_t  highres_graphics_flag = (CGA_MODE_FLAG_HIGHRES_GRAPHICS | CGA_MODE_FLAG_GRAPHICS);
 
@@ -301,17 +317,10 @@ cga_render(cga_t *cga, int line)
                     cols[1] = cols[0];
             } else
                 cols[0] = (attr >> 4) + 16;
-            if (drawcursor) {
-                for (column = 0; column < 8; column++) {
-                    buffer32->line[line][(x << 3) + column + 8]
-                        = cols[(fontdat[chr + cga->fontbase][cga->scanline & 7] & (1 << (column ^ 7))) ? 1 : 0] ^ 15;
-                }
-            } else {
-                for (column = 0; column < 8; column++) {
-                    buffer32->line[line][(x << 3) + column + 8]
-                        = cols[(fontdat[chr + cga->fontbase][cga->scanline & 7] & (1 << (column ^ 7))) ? 1 : 0];
-                }
-            }
+            inv = drawcursor ? 15 : 0;
+            row = glyph_cache_row(&cga_glyph_cache, (cols[1] & 15) ^ inv, (cols[0] & 15) ^ inv,
+                                  fontdat[chr + cga->fontbase][cga->scanline & 7]);
+            memcpy(&buffer32->line[line][(x << 3) + 8], row, 8 * sizeof(uint32_t));
             cga->memaddr++;
         }
     } else if (!(cga->cgamode & CGA_MODE_FLAG_GRAPHICS)) {
@@ -330,18 +339,13 @@ cga_render(cga_t *cga, int line)
             } else
                 cols[0] = (attr >> 4) + 16;
             cga->memaddr++;
-            if (drawcursor) {
-                for (column = 0; column < 8; column++) {
-                    buffer32->line[line][(x << 4) + (column << 1) + 8]
-                        = buffer32->line[line][(x << 4) + (column << 1) + 9]
-                        = cols[(fontdat[chr + cga->fontbase][cga->scanline & 7] & (1 << (column ^ 7))) ? 1 : 0] ^ 15;
-                }
-            } else {
-                for (column = 0; column < 8; column++) {
-                    buffer32->line[line][(x << 4) + (column << 1) + 8]
-                        = buffer32->line[line][(x << 4) + (column << 1) + 9] 
-                        = cols[(fontdat[chr + cga->fontbase][cga->scanline & 7] & (1 << (column ^ 7))) ? 1 : 0];
-                }
+            inv = drawcursor ? 15 : 0;
+            row = glyph_cache_row(&cga_glyph_cache, (cols[1] & 15) ^ inv, (cols[0] & 15) ^ inv,
+                                  fontdat[chr + cga->fontbase][cga->scanline & 7]);
+            for (column = 0; column < 8; column++) {
+                buffer32->line[line][(x << 4) + (column << 1) + 8]
+                    = buffer32->line[line][(x << 4) + (column << 1) + 9]
+                    = row[column];
             }
         }
     } else if (!(cga->cgamode & CGA_MODE_FLAG_HIGHRES_GRAPHICS)) { /* not hi-res (but graphics) => 4-color mode */
@@ -752,6 +756,8 @@ cga_init(cga_t *cga)
 {
     timer_add(&cga->timer, cga_poll, cga, 1);
     cga->composite = 0;
+
+    cga_glyph_cache_init();
 }
 
 void *
@@ -770,6 +776,7 @@ cga_standalone_init(UNUSED(const device_t *info))
     cga->vram = malloc(DEVICE_VRAM);
 
     cga_comp_init(cga->revision);
+    cga_glyph_cache_init();
     timer_add(&cga->timer, cga_poll, cga, 1);
     mem_mapping_add(&cga->mapping, 0xb8000, 0x08000, cga_read, NULL, NULL, cga_write, NULL, NULL, NULL /*cga->vram*/, MEM_MAPPING_EXTERNAL, cga);
     io_sethandler(0x03d0, 0x0010, cga_in, NULL, NULL, cga_out, NULL, NULL, cga);
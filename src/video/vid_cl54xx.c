@@ -3602,6 +3602,35 @@ gd54xx_transparent_comp(gd54xx_t *gd54xx, uint32_t xx, uint8_t src)
     return ret;
 }
 
+/* Solid colour fill with the colour written straight through: fill it a
+   row at a time. Returns 0 to leave the blit to the byte loop. */
+static int
+gd54xx_pattern_fill_bulk(gd54xx_t *gd54xx)
+{
+    svga_t  *svga   = &gd54xx->svga;
+    int      pw     = gd54xx->blt.pixel_width;
+    uint32_t pixels = (gd54xx->blt.width / pw) + 1;
+    uint32_t rows   = gd54xx->blt.height + 1;
+    uint32_t dsta;
+
+    if (((gd54xx->blt.mode & (CIRRUS_BLTMODE_COLOREXPAND | CIRRUS_BLTMODE_TRANSPARENTCOMP)) != CIRRUS_BLTMODE_COLOREXPAND) ||
+        !(gd54xx->blt.modeext & CIRRUS_BLTMODEEXT_SOLIDFILL) || (gd54xx->blt.rop != 0x0d) || gd54xx->blt.pattern_x)
+        return 0;
+
+    for (uint32_t y = 0; y < rows; y++) {
+        dsta = (gd54xx->blt.dst_addr + (y * gd54xx->blt.dst_pitch)) & gd54xx->vram_mask;
+        if ((dsta + (pixels * pw)) > (gd54xx->vram_mask + 1))
+            return 0;
+    }
+
+    for (uint32_t y = 0; y < rows; y++) {
+        dsta = (gd54xx->blt.dst_addr + (y * gd54xx->blt.dst_pitch)) & gd54xx->vram_mask;
+        svga_blit_fill(svga, dsta, gd54xx->blt.fg_col, pw, pixels);
+    }
+
+    return 1;
+}
+
 static void
 gd54xx_pattern_copy(gd54xx_t *gd54xx)
 {
@@ -3617,6 +3646,9 @@ gd54xx_pattern_copy(gd54xx_t *gd54xx)
     uint32_t dsta;
     svga_t  *svga = &gd54xx->svga;
 
+    if (gd54xx_pattern_fill_bulk(gd54xx))
+        return;
+
     pattern_pitch = gd54xx->blt.pixel_width << 3;
 
     if (gd54xx->blt.pixel_width == 3)
@@ -3776,6 +3808,56 @@ gd54xx_mem_sys_src(gd54xx_t *gd54xx, uint32_t cpu_dat, uint32_t count)
     }
 }
 
+/* Row span of a normal blit, as the lowest byte address it touches; the
+   blit walks it downwards when running backwards. */
+static uint32_t
+gd54xx_normal_blit_row(gd54xx_t *gd54xx, uint32_t addr, uint16_t pitch, uint32_t y)
+{
+    addr = (addr + (pitch * y * gd54xx->blt.dir)) & gd54xx->vram_mask;
+
+    if (gd54xx->blt.dir < 0)
+        addr -= gd54xx->blt.width;
+
+    return addr;
+}
+
+/* Screen to screen copy with the source written straight through: move it
+   a row at a time. Returns 0 to leave the blit to the byte loop. */
+static int
+gd54xx_normal_blit_bulk(uint32_t count, gd54xx_t *gd54xx, svga_t *svga)
+{
+    uint32_t len  = gd54xx->blt.width + 1;
+    uint32_t rows = gd54xx->blt.height + 1;
+    uint32_t src;
+    uint32_t dst;
+
+    if ((gd54xx->blt.mode & (CIRRUS_BLTMODE_COLOREXPAND | CIRRUS_BLTMODE_TRANSPARENTCOMP)) ||
+        (gd54xx->blt.rop != 0x0d) || (count < ((uint64_t) len * rows)))
+        return 0;
+
+    for (uint32_t y = 0; y < rows; y++) {
+        src = gd54xx_normal_blit_row(gd54xx, gd54xx->blt.src_addr, gd54xx->blt.src_pitch, y);
+        dst = gd54xx_normal_blit_row(gd54xx, gd54xx->blt.dst_addr, gd54xx->blt.dst_pitch, y);
+        if ((src > gd54xx->vram_mask) || ((src + len) > (gd54xx->vram_mask + 1)) ||
+            (dst > gd54xx->vram_mask) || ((dst + len) > (gd54xx->vram_mask + 1)))
+            return 0;
+    }
+
+    for (uint32_t y = 0; y < rows; y++) {
+        src = gd54xx_normal_blit_row(gd54xx, gd54xx->blt.src_addr, gd54xx->blt.src_pitch, y);
+        dst = gd54xx_normal_blit_row(gd54xx, gd54xx->blt.dst_addr, gd54xx->blt.dst_pitch, y);
+        svga_blit_copy(svga, dst, src, len, gd54xx->blt.dir < 0);
+    }
+
+    gd54xx->blt.dst_addr_backup = (gd54xx->blt.dst_addr + (gd54xx->blt.dst_pitch * rows * gd54xx->blt.dir)) & gd54xx->vram_mask;
+    gd54xx->blt.src_addr_backup = (gd54xx->blt.src_addr + (gd54xx->blt.src_pitch * rows * gd54xx->blt.dir)) & gd54xx->vram_mask;
+    gd54xx->blt.y_count         = (rows * gd54xx->blt.dir) & 7;
+    gd54xx->blt.x_count         = 0;
+    gd54xx->blt.height_internal = 0xffff;
+
+    return 1;
+}
+
 static void
 gd54xx_normal_blit(uint32_t count, gd54xx_t *gd54xx, svga_t *svga)
 {
@@ -3796,6 +3878,11 @@ gd54xx_normal_blit(uint32_t count, gd54xx_t *gd54xx, svga_t *svga)
     gd54xx->blt.x_count         = 0;
     gd54xx->blt.y_count         = 0;
 
+    if (gd54xx_normal_blit_bulk(count, gd54xx, svga)) {
+        gd54xx_reset_blit(gd54xx);
+        return;
+    }
+
     while (count) {
         src  = 0;
         mask = 0;
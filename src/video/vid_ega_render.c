@@ -102,6 +102,10 @@ ega_render_overscan_right(ega_t *ega)
         buffer32->line[ega->displine + ega->y_add][ega->x_add + ega->hdisp + i] = ega->overscan_color;
 }
 
+/* Shared by all EGAs; a second one with another palette only costs the
+   rebuilding of the pairs it draws. */
+static glyph_cache_t ega_glyph_cache;
+
 void
 ega_render_text(ega_t *ega)
 {
@@ -130,6 +134,14 @@ ega_render_text(ega_t *ega)
         const bool blinked       = ega->blink & 0x10;
         uint32_t  *p             = &buffer32->line[ega->displine + ega->y_add][ega->x_add];
 
+        if (!monoattrs) {
+            uint32_t pal[16];
+
+            for (int c = 0; c < 16; c++)
+                pal[c] = ega->pallook[ega->egapal[c]];
+            glyph_cache_set_palette(&ega_glyph_cache, pal);
+        }
+
         /* Compensate for 8dot scroll */
         if (!seq9dot) {
             for (int x = 0; x < dotwidth; x++) {
@@ -160,26 +172,27 @@ ega_render_text(ega_t *ega)
             int fg;
             int bg;
             if (drawcursor) {
-                bg = ega->pallook[ega->egapal[attr & 0x0f]];
-                fg = ega->pallook[ega->egapal[attr >> 4]];
+                bg = attr & 0x0f;
+                fg = attr >> 4;
             } else {
-                fg = ega->pallook[ega->egapal[attr & 0x0f]];
-                bg = ega->pallook[ega->egapal[attr >> 4]];
+                fg = attr & 0x0f;
+                bg = attr >> 4;
 
                 if ((attr & 0x80) && attrblink) {
-                    bg = ega->pallook[ega->egapal[(attr >> 4) & 7]];
+                    bg = (attr >> 4) & 7;
                     if (blinked)
                         fg = bg;
                 }
             }
 
             uint32_t dat = ega->vram[charaddr + (ega->scanline << 2)];
-            dat <<= 1;
-            if (((chr & ~0x1f) == 0xc0) && attrlinechars)
-                dat |= (dat >> 1) & 1;
 
-            for (int xx = 0; xx < charwidth; xx++) {
-                if (monoattrs) {
+            if (monoattrs) {
+                dat <<= 1;
+                if (((chr & ~0x1f) == 0xc0) && attrlinechars)
+                    dat |= (dat >> 1) & 1;
+
+                for (int xx = 0; xx < charwidth; xx++) {
                     int bit   = (dat & (0x100 >> (xx >> dwshift))) ? 1 : 0;
                     int blink = (!drawcursor && (attr & 0x80) && attrblink && blinked);
                     if ((ega->scanline == ega->crtc[0x14]) && ((attr & 7) == 1))
@@ -189,8 +202,22 @@ ega_render_text(ega_t *ega)
                     if (drawcursor)
                         p[xx] ^= ega->mda_attr_to_color_table[attr][0][1];
                     p[xx] = ega->pallook[ega->egapal[p[xx] & 0x0f]];
+                }
+            } else {
+                const uint32_t *row = glyph_cache_row(&ega_glyph_cache, fg, bg, dat);
+
+                if (doublewidth) {
+                    for (int xx = 0; xx < 8; xx++)
+                        p[xx << 1] = p[(xx << 1) + 1] = row[xx];
                 } else
-                    p[xx] = (dat & (0x100 >> (xx >> dwshift))) ? fg : bg;
+                    memcpy(p, row, 8 * sizeof(uint32_t));
+
+                if (seq9dot) {
+                    const uint32_t col = (((chr & ~0x1f) == 0xc0) && attrlinechars) ? row[7] : ega_glyph_cache.pal[bg];
+
+                    for (int xx = 8 << dwshift; xx < charwidth; xx++)
+                        p[xx] = col;
+                }
             }
 
             ega->memaddr += 4;
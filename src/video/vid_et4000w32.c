@@ -2336,6 +2336,113 @@ et4000w32_blit(int count, int cpu_input, uint32_t src_dat, uint32_t mix_dat, et4
     }
 }
 
+/*One row of a W32p SRCCOPY or PATCOPY blit, starting at dest_back. Rows
+  that are linear in VRAM are moved or filled in one go, anything else goes
+  a byte at a time exactly like the ROPMIX loop would.*/
+static void
+et4000w32p_blit_bulk_row(et4000w32p_t *et4000, uint32_t w, int xdir, int period)
+{
+    svga_t  *svga = &et4000->svga;
+    uint32_t mask = et4000->vram_mask;
+    uint32_t dst  = et4000->acl.dest_back & mask;
+    uint32_t lo   = (xdir > 0) ? dst : (dst - (w - 1));
+    int      px   = et4000->acl.pattern_x_back;
+
+    if (!period) {
+        uint32_t src    = (et4000->acl.source_addr + et4000->acl.source_x_back) & mask;
+        uint32_t src_lo = (xdir > 0) ? src : (src - (w - 1));
+
+        if ((lo <= mask) && ((lo + w) <= (mask + 1)) && (src_lo <= mask) && ((src_lo + w) <= (mask + 1))) {
+            svga_blit_copy(svga, lo, src_lo, w, xdir < 0);
+            return;
+        }
+
+        for (uint32_t x = 0; x < w; x++) {
+            svga->vram[(dst + (x * xdir)) & mask]                = svga->vram[(src + (x * xdir)) & mask];
+            svga->changedvram[((dst + (x * xdir)) & mask) >> 12] = changeframecount;
+        }
+    } else {
+        uint32_t pat = et4000->acl.pattern_addr & mask;
+
+        if (((lo + w) <= (mask + 1)) && ((pat + period) <= (mask + 1)) &&
+            (((pat + period) <= lo) || (pat >= (lo + w)))) {
+            uint32_t done = MIN(w, (uint32_t) period);
+
+            for (uint32_t x = 0; x < done; x++) {
+                svga->vram[lo + x] = svga->vram[pat + px];
+                if (++px >= period)
+                    px -= period;
+            }
+            /*The row now starts with whole periods of the pattern; keep
+              doubling them until it is full.*/
+            done -= (done % period);
+            if (done) {
+                while (done < w) {
+                    uint32_t len = MIN(done, w - done);
+
+                    memcpy(&svga->vram[lo + done], &svga->vram[lo], len);
+                    done += len;
+                }
+            }
+            svga_blit_changed(svga, lo, w);
+            return;
+        }
+
+        for (uint32_t x = 0; x < w; x++) {
+            svga->vram[(dst + x) & mask]                = svga->vram[(et4000->acl.pattern_addr + px) & mask];
+            svga->changedvram[((dst + x) & mask) >> 12] = changeframecount;
+            if (++px >= period)
+                px -= period;
+        }
+    }
+}
+
+/*A BitBLT started by the destination address write that is a plain
+  SRCCOPY, or a PATCOPY with a short repeating pattern, and involves neither
+  a mix map nor CPU data: run it a row at a time. Returns 0 to leave it to
+  the ROPMIX loop.*/
+static int
+et4000w32p_blit_bulk(et4000w32p_t *et4000)
+{
+    uint32_t w      = et4000->acl.internal.count_x + 1;
+    uint32_t h      = et4000->acl.internal.count_y + 1;
+    int      xdir   = (et4000->acl.internal.xy_dir & 1) ? -1 : 1;
+    int      period = 0;
+
+    if ((et4000->acl.internal.xy_dir & 0x80) || ((et4000->acl.internal.ctrl_routing & 0xa) == 8) ||
+        (et4000->acl.internal.ctrl_routing & 0x43) || (et4000->acl.x_count != et4000->acl.internal.count_x) ||
+        (et4000->acl.y_count != et4000->acl.internal.count_y) || (et4000->acl.dest_addr != et4000->acl.dest_back) ||
+        (et4000->acl.pattern_x != et4000->acl.pattern_x_back) || (et4000->acl.source_x != et4000->acl.source_x_back))
+        return 0;
+
+    if (et4000->acl.internal.rop_fg == 0xf0) {
+        period = et4000w32_max_x[et4000->acl.internal.pattern_wrap & 7];
+        if ((xdir < 0) || (period < 1) || (period > 0x40) || (et4000->acl.pattern_x_back >= period))
+            return 0;
+    } else if ((et4000->acl.internal.rop_fg != 0xcc) || ((et4000->acl.internal.source_wrap & 0x47) != 0x47))
+        return 0;
+
+    for (uint32_t y = 0; y < h; y++) {
+        et4000w32p_blit_bulk_row(et4000, w, xdir, period);
+
+        if (et4000->acl.internal.xy_dir & 2) {
+            et4000w32_decy(et4000);
+            et4000->acl.mix_back = et4000->acl.mix_addr = et4000->acl.mix_back - (et4000->acl.internal.mix_off + 1);
+            et4000->acl.dest_back = et4000->acl.dest_addr = et4000->acl.dest_back - (et4000->acl.internal.dest_off + 1);
+        } else {
+            et4000w32_incy(et4000);
+            et4000->acl.mix_back = et4000->acl.mix_addr = et4000->acl.mix_back + et4000->acl.internal.mix_off + 1;
+            et4000->acl.dest_back = et4000->acl.dest_addr = et4000->acl.dest_back + et4000->acl.internal.dest_off + 1;
+        }
+    }
+
+    et4000->acl.y_count = 0xffff;
+    et4000w32_log("BitBLT end\n");
+    et4000->acl.status &= ~(ACL_XYST | ACL_SSO);
+
+    return 1;
+}
+
 static void
 et4000w32p_blit(int count, uint32_t mix, uint32_t sdat, int cpu_input, et4000w32p_t *et4000)
 {
@@ -2467,6 +2574,9 @@ et4000w32p_blit(int count, uint32_t mix, uint32_t sdat, int cpu_input, et4000w32
         }
     } else {
         et4000w32_log("BitBLT: count = %i\n", count);
+        if ((count == -1) && !cpu_input && (mix == 0xffffffff) && et4000w32p_blit_bulk(et4000))
+            return;
+
         while (count-- && (et4000->acl.y_count >= 0)) {
             pattern = svga->vram[(et4000->acl.pattern_addr + et4000->acl.pattern_x) & et4000->vram_mask];
 
@@ -2921,7 +3031,9 @@ et4000w32p_init(const device_t *info)
         if (!et4000->onboard_vid)
             mem_mapping_disable(&et4000->bios_rom.mapping);
     }
-    mem_mapping_add(&et4000->linear_mapping, 0, 0, svga_read_linear, svga_readw_linear, svga_readl_linear, svga_write_linear, svga_writew_linear, svga_writel_linear, NULL, MEM_MAPPING_EXTERNAL, &et4000->svga);
+    mem_mapping_add(&et4000->linear_mapping, 0, 0, svga_read_linear, svga_readw_linear, svga_readl_linear, svga_write_linear, svga_writew_lfb, svga_writel_lfb, NULL, MEM_MAPPING_EXTERNAL, &et4000->svga);
+    mem_mapping_set_block_handler(&et4000->linear_mapping, svga_read_block_linear, svga_write_block_linear);
+    et4000->svga.direct_lfb = 1;
     mem_mapping_add(&et4000->mmu_mapping, 0, 0, et4000w32p_mmu_read, NULL, NULL, et4000w32p_mmu_write, NULL, NULL, NULL, MEM_MAPPING_EXTERNAL, et4000);
 
     et4000w32p_io_set(et4000);
@@ -46,6 +46,9 @@ enum mda_monitor_type_e {
 // [attr][blink][fg]
 static int mda_attr_to_color_table[256][2][2];
 
+// Text is drawn in palette indices 16 to 31 in both monitor modes, so the cache never needs invalidating
+static glyph_cache_t mda_glyph_cache;
+
 static video_timings_t timing_mda = { .type = VIDEO_ISA, .write_b = 8, .write_w = 16, .write_l = 32, .read_b = 8, .read_w = 16, .read_l = 32 };
 
 void mda_recalctimings(mda_t *mda);
@@ -215,46 +218,23 @@ mda_poll(void *priv)
                             buffer32->line[mda->displine][(x * 9) + column] = mda_attr_to_color_table[attr][blink][1];
                     }
                 } else { // character
-                    for (uint32_t column = 0; column < 8; column++) {
-                        // bg=0, fg=1
-                        bool is_fg = (fontdatm[chr + mda->fontbase][mda->scanline] & (1 << (column ^ 7))) ? 1 : 0;
-
-                        uint32_t font_char = mda_attr_to_color_table[attr][blink][is_fg];
-
-                        if (mda->monitor_type == MDA_MONITOR_TYPE_RGBI
-                            && !(mda->mode & MDA_MODE_BW)) {
-                            if (!is_fg)
-                                font_char = CGAPAL_CGA_START + color_bg;
-                            else
-                                font_char = CGAPAL_CGA_START + color_fg;
-                        }
-
-                        buffer32->line[mda->displine][(x * 9) + column] = font_char;
+                    // the colour table holds CGAPAL_CGA_START-based indices too
+                    if (!(mda->monitor_type == MDA_MONITOR_TYPE_RGBI
+                          && !(mda->mode & MDA_MODE_BW))) {
+                        color_bg = mda_attr_to_color_table[attr][blink][0] & 0x0f;
+                        color_fg = mda_attr_to_color_table[attr][blink][1] & 0x0f;
                     }
 
-                    // these characters (C0-DF) have their background extended to their 9th column
-                    if ((chr & ~0x1f) == 0xc0) {
-                        bool     is_fg        = fontdatm[chr + mda->fontbase][mda->scanline] & 1;
-                        uint32_t final_result = mda_attr_to_color_table[attr][blink][is_fg];
+                    const uint32_t *row = glyph_cache_row(&mda_glyph_cache, color_fg, color_bg,
+                                                          fontdatm[chr + mda->fontbase][mda->scanline]);
 
-                        if (mda->monitor_type == MDA_MONITOR_TYPE_RGBI
-                            && !(mda->mode & MDA_MODE_BW)) {
-                            if (!is_fg)
-                                final_result = CGAPAL_CGA_START + color_bg;
-                            else
-                                final_result = CGAPAL_CGA_START + color_fg;
-                        }
+                    memcpy(&buffer32->line[mda->displine][x * 9], row, 8 * sizeof(uint32_t));
 
-                        buffer32->line[mda->displine][(x * 9) + 8] = final_result;
-
-                    } else {
-                        if (mda->monitor_type == MDA_MONITOR_TYPE_RGBI
-                            && !(mda->mode & MDA_MODE_BW)) {
-                            buffer32->line[mda->displine][(x * 9) + 8] = CGAPAL_CGA_START + color_bg;
-
-                        } else
-                            buffer32->line[mda->displine][(x * 9) + 8] = mda_attr_to_color_table[attr][blink][0];
-                    }
+                    // these characters (C0-DF) have their background extended to their 9th column
+                    if ((chr & ~0x1f) == 0xc0)
+                        buffer32->line[mda->displine][(x * 9) + 8] = row[7];
+                    else
+                        buffer32->line[mda->displine][(x * 9) + 8] = CGAPAL_CGA_START + color_bg;
                 }
 
                 mda->memaddr++;
@@ -377,6 +357,11 @@ mda_poll(void *priv)
 void
 mda_init(mda_t *mda)
 {
+    uint32_t pal[16];
+
+    for (int c = 0; c < 16; c++)
+        pal[c] = CGAPAL_CGA_START + c;
+    glyph_cache_set_palette(&mda_glyph_cache, pal);
 
     for (uint16_t attr = 0; attr < 256; attr++) {
         mda_attr_to_color_table[attr][0][0] = mda_attr_to_color_table[attr][1][0] = mda_attr_to_color_table[attr][1][1] = 16;
@@ -3515,6 +3515,81 @@ blit_idump_read(mystique_t *mystique)
     return ret;
 }
 
+/*Copy of whole source rows to destination rows that lie entirely inside
+  the clip rectangle, with the source written straight through. Moves it a
+  row at a time; returns 0 to leave the blit to the pixel loop.*/
+static int
+blit_bitblt_bulk(mystique_t *mystique)
+{
+    svga_t  *svga  = &mystique->svga;
+    int      x_dir = mystique->dwgreg.sgn.scanleft ? -1 : 1;
+    int16_t  x_lo  = mystique->dwgreg.fxleft;
+    int16_t  x_hi  = mystique->dwgreg.fxright;
+    uint32_t pitch = mystique->dwgreg.pitch & PITCH_MASK;
+    uint32_t ydst  = mystique->dwgreg.ydst_lin;
+    uint32_t src   = mystique->dwgreg.ar[3];
+    uint32_t len;
+    int      bpp;
+
+    switch (mystique->maccess_running & MACCESS_PWIDTH_MASK) {
+        case MACCESS_PWIDTH_8:
+            bpp = 1;
+            break;
+        case MACCESS_PWIDTH_16:
+            bpp = 2;
+            break;
+        case MACCESS_PWIDTH_24:
+            bpp = 3;
+            break;
+        case MACCESS_PWIDTH_32:
+            bpp = 4;
+            break;
+        default:
+            return 0;
+    }
+
+    if ((x_lo > x_hi) || (x_lo < mystique->dwgreg.cxleft) || (x_hi > mystique->dwgreg.cxright))
+        return 0;
+
+    /*Each source row has to end exactly where the destination row does.*/
+    len = x_hi - x_lo + 1;
+    if (mystique->dwgreg.ar[0] != (src + ((len - 1) * x_dir)))
+        return 0;
+
+    if (mystique->dwgreg.sgn.sdy)
+        pitch = -pitch;
+
+    for (uint16_t y = 0; y < mystique->dwgreg.length; y++) {
+        uint32_t src_lo = (((x_dir > 0) ? src : (src - len + 1)) * bpp) & mystique->vram_mask;
+        uint32_t dst_lo = ((ydst + x_lo) * bpp) & mystique->vram_mask;
+
+        if ((ydst < mystique->dwgreg.ytop) || (ydst > mystique->dwgreg.ybot) ||
+            ((src_lo + (len * bpp)) > (mystique->vram_mask + 1)) || ((dst_lo + (len * bpp)) > (mystique->vram_mask + 1)))
+            return 0;
+
+        src += mystique->dwgreg.ar[5];
+        ydst += pitch;
+    }
+
+    src  = mystique->dwgreg.ar[3];
+    ydst = mystique->dwgreg.ydst_lin;
+    for (uint16_t y = 0; y < mystique->dwgreg.length; y++) {
+        uint32_t src_lo = (((x_dir > 0) ? src : (src - len + 1)) * bpp) & mystique->vram_mask;
+        uint32_t dst_lo = ((ydst + x_lo) * bpp) & mystique->vram_mask;
+
+        svga_blit_copy(svga, dst_lo, src_lo, len * bpp, x_dir < 0);
+
+        src += mystique->dwgreg.ar[5];
+        ydst += pitch;
+    }
+
+    mystique->dwgreg.ar[0] += mystique->dwgreg.ar[5] * mystique->dwgreg.length;
+    mystique->dwgreg.ar[3] = src;
+    mystique->dwgreg.ydst_lin = ydst;
+
+    return 1;
+}
+
 static void
 blit_fbitblt(mystique_t *mystique)
 {
@@ -3524,6 +3599,11 @@ blit_fbitblt(mystique_t *mystique)
     int16_t  x_start = mystique->dwgreg.sgn.scanleft ? mystique->dwgreg.fxright : mystique->dwgreg.fxleft;
     int16_t  x_end   = mystique->dwgreg.sgn.scanleft ? mystique->dwgreg.fxleft : mystique->dwgreg.fxright;
 
+    if (blit_bitblt_bulk(mystique)) {
+        mystique->blitter_complete_refcount++;
+        return;
+    }
+
     src_addr = mystique->dwgreg.ar[3];
 
     for (uint16_t y = 0; y < mystique->dwgreg.length; y++) {
@@ -5923,6 +6003,10 @@ blit_bitblt(mystique_t *mystique)
 
                 case DWGCTRL_BLTMOD_BFCOL:
                 case DWGCTRL_BLTMOD_BU32RGB:
+                    if (((mystique->dwgreg.dwgctrl_running & DWGCTRL_BOP_MASK) == BOP(0xc)) && !trans_sel &&
+                        !(mystique->dwgreg.dwgctrl_running & (DWGCTRL_TRANSC | DWGCTRL_PATTERN)) && blit_bitblt_bulk(mystique))
+                        break;
+
                     src_addr = mystique->dwgreg.ar[3];
 
                     for (y = 0; y < mystique->dwgreg.length; y++) {
@@ -2830,22 +2830,45 @@ s3_trio64v_overlay_draw(svga_t *svga, int displine)
     else
         x_size = s3->streams.sec_w + 1;
 
-    OVERLAY_SAMPLE();
+    if ((s3->streams.sdif == 1) && (x_size > 0) && (x_size <= 2048)) {
+        /*Convert every source pixel the scaler can reach in one go; this is
+          the same span the four pixel ring below would decode.*/
+        uint32_t line[2048 + 4];
+        int      src_x = 0;
 
-    for (int x = 0; x < x_size; x++) {
-        if (s3_trio64v_colorkey(s3, offset + x, displine - svga->y_add))
-            *p++ = r[x_read] | (g[x_read] << 8) | (b[x_read] << 16);
-        else
-            p++;
+        svga_line_yuv422to32(line, src, SVGA_YUV_V_FIRST | SVGA_YUV_BGR, ((x_size >> 2) + 1) << 2);
 
-        svga->overlay_latch.h_acc += s3->streams.k1_horiz_scale;
-        if (svga->overlay_latch.h_acc >= 0) {
-            if ((x_read ^ (x_read + 1)) & ~3)
-                OVERLAY_SAMPLE();
+        for (int x = 0; x < x_size; x++) {
+            if (s3_trio64v_colorkey(s3, offset + x, displine - svga->y_add))
+                *p++ = line[src_x];
+            else
+                p++;
 
-            x_read = (x_read + 1) & 7;
+            svga->overlay_latch.h_acc += s3->streams.k1_horiz_scale;
+            if (svga->overlay_latch.h_acc >= 0) {
+                src_x++;
 
-            svga->overlay_latch.h_acc += (s3->streams.k2_horiz_scale - s3->streams.k1_horiz_scale);
+                svga->overlay_latch.h_acc += (s3->streams.k2_horiz_scale - s3->streams.k1_horiz_scale);
+            }
+        }
+    } else {
+        OVERLAY_SAMPLE();
+
+        for (int x = 0; x < x_size; x++) {
+            if (s3_trio64v_colorkey(s3, offset + x, displine - svga->y_add))
+                *p++ = r[x_read] | (g[x_read] << 8) | (b[x_read] << 16);
+            else
+                p++;
+
+            svga->overlay_latch.h_acc += s3->streams.k1_horiz_scale;
+            if (svga->overlay_latch.h_acc >= 0) {
+                if ((x_read ^ (x_read + 1)) & ~3)
+                    OVERLAY_SAMPLE();
+
+                x_read = (x_read + 1) & 7;
+
+                svga->overlay_latch.h_acc += (s3->streams.k2_horiz_scale - s3->streams.k1_horiz_scale);
+            }
         }
     }
 
@@ -8326,6 +8349,134 @@ s3_short_stroke_start(s3_t *s3, uint8_t ssv)
     s3->accel_start(-1, 0, -1, 0, s3);
 }
 
+/*Bytes per pixel for the bulk paths of the drawing engine, or 0 when its
+  accesses are remapped or split up and have to stay per pixel.*/
+static int
+s3_accel_bulk_bpp(s3_t *s3)
+{
+    const svga_t *svga = &s3->svga;
+
+    if (!svga->packed_chain4 && !svga->force_old_addr)
+        return 0;
+    if ((s3->bpp == 2) || (svga->bpp == 24) || s3->accel.rd_mask_16bit_check || s3->accel.minus)
+        return 0;
+
+    if ((s3->bpp == 0) && !s3->color_16bit)
+        return 1;
+    if ((s3->bpp == 1) || s3->color_16bit)
+        return 2;
+
+    return 4;
+}
+
+/*Check that every row of a bulk operation is a linear span of VRAM.*/
+static int
+s3_accel_bulk_rows(s3_t *s3, uint32_t base, int x, int y, int y_inc, int w, int h, int bpp)
+{
+    for (int c = 0; c < h; c++) {
+        uint32_t addr = ((base + (y + (c * y_inc)) * s3->width + x) * bpp) & s3->vram_mask;
+
+        if ((addr + (w * bpp)) > (s3->vram_mask + 1))
+            return 0;
+    }
+
+    return 1;
+}
+
+/*Screen to screen copy with the source written straight through, left to
+  right and top to bottom, and entirely inside the clip rectangle: move it
+  a row at a time. Returns 0 to leave the operation to the pixel loop.*/
+static int
+s3_accel_bitblt_bulk(s3_t *s3, uint32_t srcbase, uint32_t dstbase, int clip_l, int clip_r, int clip_t, int clip_b, uint32_t wrt_mask)
+{
+    svga_t  *svga = &s3->svga;
+    int      bpp  = s3_accel_bulk_bpp(s3);
+    int      w    = (s3->accel.maj_axis_pcnt & 0xfff) + 1;
+    int      h    = s3->accel.sy + 1;
+    uint32_t pix_mask;
+
+    if (!bpp || !(s3->accel.cmd & 0x10) || (s3->accel.sx != (w - 1)))
+        return 0;
+
+    pix_mask = (bpp == 4) ? 0xffffffff : ((1 << (bpp << 3)) - 1);
+    if ((wrt_mask & pix_mask) != pix_mask)
+        return 0;
+
+    if ((s3->accel.dx < clip_l) || ((s3->accel.dx + w - 1) > clip_r) || ((s3->accel.dx + w) > 0xfff) ||
+        (s3->accel.dy < clip_t) || ((s3->accel.dy + h - 1) > clip_b))
+        return 0;
+
+    if (!s3_accel_bulk_rows(s3, srcbase, s3->accel.cx, s3->accel.cy, 1, w, h, bpp) ||
+        !s3_accel_bulk_rows(s3, dstbase, s3->accel.dx, s3->accel.dy, 1, w, h, bpp))
+        return 0;
+
+    for (int y = 0; y < h; y++) {
+        uint32_t src = ((srcbase + (s3->accel.cy + y) * s3->width + s3->accel.cx) * bpp) & s3->vram_mask;
+        uint32_t dst = ((dstbase + (s3->accel.dy + y) * s3->width + s3->accel.dx) * bpp) & s3->vram_mask;
+
+        svga_blit_copy(svga, dst, src, w * bpp, 0);
+    }
+
+    s3->accel.cy += h;
+    s3->accel.dy += h;
+    s3->accel.sy = -1;
+
+    s3->accel.src  = srcbase + (s3->accel.cy * s3->width);
+    s3->accel.dest = dstbase + (s3->accel.dy * s3->width);
+
+    s3->accel.destx_distp = s3->accel.dx;
+    s3->accel.desty_axstp = s3->accel.dy;
+
+    return 1;
+}
+
+/*Rectangle fill with a plain colour written straight through and entirely
+  inside the clip rectangle.*/
+static int
+s3_accel_rectfill_bulk(s3_t *s3, uint32_t dstbase, int clip_l, int clip_r, int clip_t, int clip_b, uint32_t wrt_mask, uint32_t col)
+{
+    svga_t  *svga  = &s3->svga;
+    int      bpp   = s3_accel_bulk_bpp(s3);
+    int      w     = (s3->accel.maj_axis_pcnt & 0xfff) + 1;
+    int      h     = s3->accel.sy + 1;
+    int      y_inc = (s3->accel.cmd & 0x80) ? 1 : -1;
+    int      x;
+    int      y;
+    uint32_t pix_mask;
+
+    if (!bpp || ((s3->accel.cmd & 0x110) != 0x10) || (s3->accel.multifunc[0xe] & 0x120) ||
+        s3->accel.color_16bit_check_pixtrans || ((s3->accel.frgd_mix & 0xf) != 7) || (s3->accel.sx != (w - 1)))
+        return 0;
+
+    pix_mask = (bpp == 4) ? 0xffffffff : ((1 << (bpp << 3)) - 1);
+    if ((wrt_mask & pix_mask) != pix_mask)
+        return 0;
+
+    x = (s3->accel.cmd & 0x20) ? s3->accel.cx : (s3->accel.cx - w + 1);
+    y = (y_inc > 0) ? s3->accel.cy : (s3->accel.cy - h + 1);
+    if ((x < clip_l) || ((x + w - 1) > clip_r) || (x < 1) || ((x + w) > 0xfff) ||
+        (y < clip_t) || ((y + h - 1) > clip_b))
+        return 0;
+
+    if (!s3_accel_bulk_rows(s3, dstbase, x, s3->accel.cy, y_inc, w, h, bpp))
+        return 0;
+
+    for (int c = 0; c < h; c++) {
+        uint32_t dst = ((dstbase + (s3->accel.cy + (c * y_inc)) * s3->width + x) * bpp) & s3->vram_mask;
+
+        svga_blit_fill(svga, dst, col & pix_mask, bpp, w);
+    }
+
+    s3->accel.cy   = (s3->accel.cy + (h * y_inc)) & 0xfff;
+    s3->accel.dest = dstbase + s3->accel.cy * s3->width;
+    s3->accel.sy   = -1;
+
+    s3->accel.cur_x = s3->accel.cx;
+    s3->accel.cur_y = s3->accel.cy;
+
+    return 1;
+}
+
 void
 s3_accel_start(int count, int cpu_input, uint32_t mix_dat, uint32_t cpu_dat, void *priv)
 {
@@ -9376,6 +9527,10 @@ s3_accel_start(int count, int cpu_input, uint32_t mix_dat, uint32_t cpu_dat, voi
                 return;
             }
 
+            if (!cpu_input && s3_accel_rectfill_bulk(s3, dstbase, clip_l, clip_r, clip_t, clip_b, wrt_mask,
+                                                     (frgd_mix == 0) ? bkgd_color : ((frgd_mix == 1) ? frgd_color : 0)))
+                return;
+
             while (count-- && (s3->accel.sy >= 0)) {
                 if (s3->accel.b2e8_pix && s3_cpu_src(s3) && !s3->accel.temp_cnt) {
                     mix_dat >>= 16;
@@ -9901,6 +10056,9 @@ s3_accel_start(int count, int cpu_input, uint32_t mix_dat, uint32_t cpu_dat, voi
 
             if (!cpu_input && (frgd_mix == 3) && !vram_mask && !(s3->accel.multifunc[0xe] & 0x100) && ((s3->accel.cmd & 0xa0) == 0xa0) && ((s3->accel.frgd_mix & 0xf) == 7) && ((s3->accel.bkgd_mix & 0xf) == 7)) {
                 s3_log("Special BitBLT.\n");
+                if (s3_accel_bitblt_bulk(s3, srcbase, dstbase, clip_l, clip_r, clip_t, clip_b, wrt_mask))
+                    return;
+
                 while (1) {
                     if ((s3->accel.dx >= clip_l) && (s3->accel.dx <= clip_r) && (s3->accel.dy >= clip_t) && (s3->accel.dy <= clip_b)) {
                         READ(s3->accel.src + s3->accel.cx - s3->accel.minus, src_dat);
@@ -11633,8 +11791,10 @@ s3_init(const device_t *info)
 
     mem_mapping_add(&s3->linear_mapping, 0, 0,
                     svga_read_linear, svga_readw_linear, svga_readl_linear,
-                    svga_write_linear, svga_writew_linear, svga_writel_linear,
+                    svga_write_linear, svga_writew_lfb, svga_writel_lfb,
                     NULL, MEM_MAPPING_EXTERNAL, &s3->svga);
+    mem_mapping_set_block_handler(&s3->linear_mapping, svga_read_block_linear, svga_write_block_linear);
+    s3->svga.direct_lfb = 1;
     /*It's hardcoded to 0xa0000 before the Trio64V+ and expects so*/
     if (chip >= S3_TRIO64V)
         mem_mapping_add(&s3->mmio_mapping, 0, 0,
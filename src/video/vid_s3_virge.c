@@ -75,9 +75,14 @@ static int dither[4][4] = {
 #define RB_SIZE 256
 #define RB_MASK (RB_SIZE - 1)
 
-#define RB_ENTRIES (virge->s3d_write_idx - virge->s3d_read_idx)
-#define RB_FULL (RB_ENTRIES == RB_SIZE)
-#define RB_EMPTY (!RB_ENTRIES)
+#define RB_ENTRIES(x) (virge->s3d_write_idx - virge->s3d_read_idx[x])
+#define RB_FULL(x) (RB_ENTRIES(x) == RB_SIZE)
+#define RB_EMPTY(x) (!RB_ENTRIES(x))
+
+/*Each render thread walks every queued triangle but only draws the scanline
+  bands it owns, so the threads never touch the same framebuffer line.*/
+#define VIRGE_MAX_RENDER_THREADS 8
+#define VIRGE_RENDER_BAND_SHIFT  2
 
 #define FIFO_SIZE 65536
 #define FIFO_MASK (FIFO_SIZE - 1)
@@ -219,13 +224,20 @@ typedef struct virge_t {
     int dithering_enabled;
     int memory_size;
 
-    int pixel_count;
-    int tri_count;
+    int render_threads;
 
-    thread_t *render_thread;
-    event_t  *wake_render_thread;
+    struct virge_render_slot_t {
+        struct virge_t *virge;
+        int             index;
+        int             pixel_count;
+        int             tri_count;
+    } render_slot[VIRGE_MAX_RENDER_THREADS];
+
+    thread_t *render_thread[VIRGE_MAX_RENDER_THREADS];
+    event_t  *wake_render_thread[VIRGE_MAX_RENDER_THREADS];
     event_t  *wake_main_thread;
-    event_t  *not_full_event;
+    event_t  *not_full_event[VIRGE_MAX_RENDER_THREADS];
+    mutex_t  *render_idle_mutex;
 
     uint32_t hwc_fg_col;
     uint32_t hwc_bg_col;
@@ -291,9 +303,9 @@ typedef struct virge_t {
     s3d_t s3d_tri;
 
     s3d_t      s3d_buffer[RB_SIZE];
-    ATOMIC_INT s3d_read_idx;
+    ATOMIC_INT s3d_read_idx[VIRGE_MAX_RENDER_THREADS];
     ATOMIC_INT s3d_write_idx;
-    ATOMIC_INT s3d_busy;
+    ATOMIC_INT s3d_busy[VIRGE_MAX_RENDER_THREADS];
 
     struct {
         uint32_t pri_ctrl;
@@ -385,6 +397,16 @@ typedef struct virge_t {
     pc_timer_t irq_timer;
 } virge_t;
 
+static __inline int
+s3_virge_render_busy(virge_t *virge)
+{
+    for (int c = 0; c < virge->render_threads; c++) {
+        if (virge->s3d_busy[c] || !RB_EMPTY(c))
+            return 1;
+    }
+    return 0;
+}
+
 static __inline void
 wake_fifo_thread(virge_t *virge)
 {
@@ -1204,7 +1226,7 @@ s3_virge_mmio_read(uint32_t addr, void *priv)
             return ret;
         case 0x8505:
             ret = 0xc0;
-            if (virge->s3d_busy || virge->virge_busy || !FIFO_EMPTY)
+            if (s3_virge_render_busy(virge) || virge->virge_busy || !FIFO_EMPTY)
                 ret |= 0x10;
             else
                 ret |= 0x30;
@@ -1252,7 +1274,7 @@ s3_virge_mmio_read_w(uint32_t addr, void *priv)
     switch (addr & 0xfffe) {
         case 0x8504:
             ret = 0xc000;
-            if (virge->s3d_busy || virge->virge_busy || !FIFO_EMPTY)
+            if (s3_virge_render_busy(virge) || virge->virge_busy || !FIFO_EMPTY)
                 ret |= 0x1000;
             else
                 ret |= 0x3000;
@@ -1355,7 +1377,7 @@ s3_virge_mmio_read_l(uint32_t addr, void *priv)
 
         case 0x8504:
             ret = 0x0000c000;
-            if (virge->s3d_busy || virge->virge_busy || !FIFO_EMPTY)
+            if (s3_virge_render_busy(virge) || virge->virge_busy || !FIFO_EMPTY)
                 ret |= 0x00001000;
             else
                 ret |= 0x00003000;
@@ -3445,6 +3467,8 @@ typedef struct rgba_t {
     int a;
 } rgba_t;
 
+struct s3d_texture_state_t;
+
 typedef struct s3d_state_t {
     int32_t r;
     int32_t g;
@@ -3482,6 +3506,14 @@ typedef struct s3d_state_t {
     int y;
 
     rgba_t dest_rgba;
+
+    void (*tex_read)(struct s3d_state_t *state, struct s3d_texture_state_t *texture_state, rgba_t *out);
+    void (*tex_sample)(struct s3d_state_t *state);
+    void (*dest_pixel)(struct s3d_state_t *state);
+
+    int render_index;
+    int render_threads;
+    int pixel_count;
 } s3d_state_t;
 
 typedef struct s3d_texture_state_t {
@@ -3492,16 +3524,9 @@ typedef struct s3d_texture_state_t {
     int32_t v;
 } s3d_texture_state_t;
 
-static void (*tex_read)(s3d_state_t *state, s3d_texture_state_t *texture_state, rgba_t *out);
-static void (*tex_sample)(s3d_state_t *state);
-static void (*dest_pixel)(s3d_state_t *state);
-
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
-static int _x;
-static int _y;
-
 static void
 tex_ARGB1555(s3d_state_t *state, s3d_texture_state_t *texture_state, rgba_t *out)
 {
@@ -3599,7 +3624,7 @@ tex_sample_normal(s3d_state_t *state)
     texture_state.u             = state->u + state->tbu;
     texture_state.v             = state->v + state->tbv;
 
-    tex_read(state, &texture_state, &state->dest_rgba);
+    state->tex_read(state, &texture_state, &state->dest_rgba);
 }
 
 static void
@@ -3618,21 +3643,21 @@ tex_sample_normal_filter(s3d_state_t *state)
 
     texture_state.u = state->u + state->tbu;
     texture_state.v = state->v + state->tbv;
-    tex_read(state, &texture_state, &tex_samples[0]);
+    state->tex_read(state, &texture_state, &tex_samples[0]);
     du = (texture_state.u >> (texture_state.texture_shift - 8)) & 0xff;
     dv = (texture_state.v >> (texture_state.texture_shift - 8)) & 0xff;
 
     texture_state.u = state->u + state->tbu + tex_offset;
     texture_state.v = state->v + state->tbv;
-    tex_read(state, &texture_state, &tex_samples[1]);
+    state->tex_read(state, &texture_state, &tex_samples[1]);
 
     texture_state.u = state->u + state->tbu;
     texture_state.v = state->v + state->tbv + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[2]);
+    state->tex_read(state, &texture_state, &tex_samples[2]);
 
     texture_state.u = state->u + state->tbu + tex_offset;
     texture_state.v = state->v + state->tbv + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[3]);
+    state->tex_read(state, &texture_state, &tex_samples[3]);
 
     d[0] = (256 - du) * (256 - dv);
     d[1] = du * (256 - dv);
@@ -3661,7 +3686,7 @@ tex_sample_mipmap(s3d_state_t *state)
     texture_state.u             = state->u + state->tbu;
     texture_state.v             = state->v + state->tbv;
 
-    tex_read(state, &texture_state, &state->dest_rgba);
+    state->tex_read(state, &texture_state, &state->dest_rgba);
 }
 
 static void
@@ -3682,21 +3707,21 @@ tex_sample_mipmap_filter(s3d_state_t *state)
 
     texture_state.u = state->u + state->tbu;
     texture_state.v = state->v + state->tbv;
-    tex_read(state, &texture_state, &tex_samples[0]);
+    state->tex_read(state, &texture_state, &tex_samples[0]);
     du = (texture_state.u >> (texture_state.texture_shift - 8)) & 0xff;
     dv = (texture_state.v >> (texture_state.texture_shift - 8)) & 0xff;
 
     texture_state.u = state->u + state->tbu + tex_offset;
     texture_state.v = state->v + state->tbv;
-    tex_read(state, &texture_state, &tex_samples[1]);
+    state->tex_read(state, &texture_state, &tex_samples[1]);
 
     texture_state.u = state->u + state->tbu;
     texture_state.v = state->v + state->tbv + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[2]);
+    state->tex_read(state, &texture_state, &tex_samples[2]);
 
     texture_state.u = state->u + state->tbu + tex_offset;
     texture_state.v = state->v + state->tbv + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[3]);
+    state->tex_read(state, &texture_state, &tex_samples[3]);
 
     d[0] = (256 - du) * (256 - dv);
     d[1] = du * (256 - dv);
@@ -3727,7 +3752,7 @@ tex_sample_persp_normal(s3d_state_t *state)
     texture_state.u             = (int32_t) (((int64_t) state->u * (int64_t) w) >> (12 + state->max_d)) + state->tbu;
     texture_state.v             = (int32_t) (((int64_t) state->v * (int64_t) w) >> (12 + state->max_d)) + state->tbv;
 
-    tex_read(state, &texture_state, &state->dest_rgba);
+    state->tex_read(state, &texture_state, &state->dest_rgba);
 }
 
 static void
@@ -3755,21 +3780,21 @@ tex_sample_persp_normal_filter(s3d_state_t *state)
 
     texture_state.u = u;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[0]);
+    state->tex_read(state, &texture_state, &tex_samples[0]);
     du = (u >> (texture_state.texture_shift - 8)) & 0xff;
     dv = (v >> (texture_state.texture_shift - 8)) & 0xff;
 
     texture_state.u = u + tex_offset;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[1]);
+    state->tex_read(state, &texture_state, &tex_samples[1]);
 
     texture_state.u = u;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[2]);
+    state->tex_read(state, &texture_state, &tex_samples[2]);
 
     texture_state.u = u + tex_offset;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[3]);
+    state->tex_read(state, &texture_state, &tex_samples[3]);
 
     d[0] = (256 - du) * (256 - dv);
     d[1] = du * (256 - dv);
@@ -3800,7 +3825,7 @@ tex_sample_persp_normal_375(s3d_state_t *state)
     texture_state.u             = (int32_t) (((int64_t) state->u * (int64_t) w) >> (8 + state->max_d)) + state->tbu;
     texture_state.v             = (int32_t) (((int64_t) state->v * (int64_t) w) >> (8 + state->max_d)) + state->tbv;
 
-    tex_read(state, &texture_state, &state->dest_rgba);
+    state->tex_read(state, &texture_state, &state->dest_rgba);
 }
 
 static void
@@ -3828,21 +3853,21 @@ tex_sample_persp_normal_filter_375(s3d_state_t *state)
 
     texture_state.u = u;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[0]);
+    state->tex_read(state, &texture_state, &tex_samples[0]);
     du = (u >> (texture_state.texture_shift - 8)) & 0xff;
     dv = (v >> (texture_state.texture_shift - 8)) & 0xff;
 
     texture_state.u = u + tex_offset;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[1]);
+    state->tex_read(state, &texture_state, &tex_samples[1]);
 
     texture_state.u = u;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[2]);
+    state->tex_read(state, &texture_state, &tex_samples[2]);
 
     texture_state.u = u + tex_offset;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[3]);
+    state->tex_read(state, &texture_state, &tex_samples[3]);
 
     d[0] = (256 - du) * (256 - dv);
     d[1] = du * (256 - dv);
@@ -3875,7 +3900,7 @@ tex_sample_persp_mipmap(s3d_state_t *state)
     texture_state.u             = (int32_t) (((int64_t) state->u * (int64_t) w) >> (12 + state->max_d)) + state->tbu;
     texture_state.v             = (int32_t) (((int64_t) state->v * (int64_t) w) >> (12 + state->max_d)) + state->tbv;
 
-    tex_read(state, &texture_state, &state->dest_rgba);
+    state->tex_read(state, &texture_state, &state->dest_rgba);
 }
 
 static void
@@ -3905,21 +3930,21 @@ tex_sample_persp_mipmap_filter(s3d_state_t *state)
 
     texture_state.u = u;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[0]);
+    state->tex_read(state, &texture_state, &tex_samples[0]);
     du = (u >> (texture_state.texture_shift - 8)) & 0xff;
     dv = (v >> (texture_state.texture_shift - 8)) & 0xff;
 
     texture_state.u = u + tex_offset;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[1]);
+    state->tex_read(state, &texture_state, &tex_samples[1]);
 
     texture_state.u = u;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[2]);
+    state->tex_read(state, &texture_state, &tex_samples[2]);
 
     texture_state.u = u + tex_offset;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[3]);
+    state->tex_read(state, &texture_state, &tex_samples[3]);
 
     d[0] = (256 - du) * (256 - dv);
     d[1] = du * (256 - dv);
@@ -3952,7 +3977,7 @@ tex_sample_persp_mipmap_375(s3d_state_t *state)
     texture_state.u             = (int32_t) (((int64_t) state->u * (int64_t) w) >> (8 + state->max_d)) + state->tbu;
     texture_state.v             = (int32_t) (((int64_t) state->v * (int64_t) w) >> (8 + state->max_d)) + state->tbv;
 
-    tex_read(state, &texture_state, &state->dest_rgba);
+    state->tex_read(state, &texture_state, &state->dest_rgba);
 }
 
 static void
@@ -3982,21 +4007,21 @@ tex_sample_persp_mipmap_filter_375(s3d_state_t *state)
 
     texture_state.u = u;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[0]);
+    state->tex_read(state, &texture_state, &tex_samples[0]);
     du = (u >> (texture_state.texture_shift - 8)) & 0xff;
     dv = (v >> (texture_state.texture_shift - 8)) & 0xff;
 
     texture_state.u = u + tex_offset;
     texture_state.v = v;
-    tex_read(state, &texture_state, &tex_samples[1]);
+    state->tex_read(state, &texture_state, &tex_samples[1]);
 
     texture_state.u = u;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[2]);
+    state->tex_read(state, &texture_state, &tex_samples[2]);
 
     texture_state.u = u + tex_offset;
     texture_state.v = v + tex_offset;
-    tex_read(state, &texture_state, &tex_samples[3]);
+    state->tex_read(state, &texture_state, &tex_samples[3]);
 
     d[0] = (256 - du) * (256 - dv);
     d[1] = du * (256 - dv);
@@ -4064,7 +4089,7 @@ dest_pixel_gouraud_shaded_triangle(s3d_state_t *state)
 static void
 dest_pixel_unlit_texture_triangle(s3d_state_t *state)
 {
-    tex_sample(state);
+    state->tex_sample(state);
 
     if (state->cmd_set & CMD_SET_ABC_SRC)
         state->dest_rgba.a = state->a >> 7;
@@ -4073,7 +4098,7 @@ dest_pixel_unlit_texture_triangle(s3d_state_t *state)
 static void
 dest_pixel_lit_texture_decal(s3d_state_t *state)
 {
-    tex_sample(state);
+    state->tex_sample(state);
 
     if (state->cmd_set & CMD_SET_ABC_SRC)
         state->dest_rgba.a = state->a >> 7;
@@ -4082,7 +4107,7 @@ dest_pixel_lit_texture_decal(s3d_state_t *state)
 static void
 dest_pixel_lit_texture_reflection(s3d_state_t *state)
 {
-    tex_sample(state);
+    state->tex_sample(state);
 
     state->dest_rgba.r += (state->r >> 7);
     state->dest_rgba.g += (state->g >> 7);
@@ -4101,7 +4126,7 @@ dest_pixel_lit_texture_modulate(s3d_state_t *state)
     int b = state->b >> 7;
     int a = state->a >> 7;
 
-    tex_sample(state);
+    state->tex_sample(state);
 
     CLAMP_RGBA(r, g, b, a);
 
@@ -4161,6 +4186,10 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
         int      xe = (state->x2 + ((1 << 20) - 1)) >> 20;
         uint32_t z  = (state->base_z > 0) ? (state->base_z << 1) : 0;
 
+        if ((state->render_threads > 1) &&
+            ((((unsigned) state->y >> VIRGE_RENDER_BAND_SHIFT) % (unsigned) state->render_threads) != (unsigned) state->render_index))
+            goto tri_skip_line;
+
         if (x_dir < 0) {
             x--;
             xe--;
@@ -4246,8 +4275,8 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
                 int      update = 1;
                 uint16_t src_z  = 0;
 
-                _x = x;
-                _y = state->y;
+                int      _x     = x;
+                int      _y     = state->y;
 
                 if (use_z) {
                     src_z = Z_READ(z_addr);
@@ -4257,7 +4286,7 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
                 if (update) {
                     uint32_t dest_col;
 
-                    dest_pixel(state);
+                    state->dest_pixel(state);
 
                     if (s3d_tri->cmd_set & CMD_SET_FE) {
                         int a              = state->a >> 7;
@@ -4322,7 +4351,7 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
                 state->w += s3d_tri->TdWdX;
                 dest_addr += x_offset;
                 z_addr += xz_offset;
-                virge->pixel_count++;
+                state->pixel_count++;
             }
         }
 
@@ -4347,7 +4376,7 @@ tri_skip_line:
 static int tex_size[8] = { 4 * 2, 2 * 2, 2 * 2, 1 * 2, 2 / 1, 2 / 1, 1 * 2, 1 * 2 };
 
 static void
-s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri)
+s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri, struct virge_render_slot_t *slot)
 {
     s3d_state_t state;
 
@@ -4366,6 +4395,10 @@ s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri)
 
     state.cmd_set = s3d_tri->cmd_set;
 
+    state.render_index   = slot->index;
+    state.render_threads = virge->render_threads;
+    state.pixel_count    = 0;
+
     state.base_u = s3d_tri->tus;
     state.base_v = s3d_tri->tvs;
     state.base_z = s3d_tri->tzs;
@@ -4385,19 +4418,19 @@ s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri)
 
     switch ((s3d_tri->cmd_set >> 27) & 0xf) {
         case 0:
-            dest_pixel = dest_pixel_gouraud_shaded_triangle;
+            state.dest_pixel = dest_pixel_gouraud_shaded_triangle;
             break;
         case 1:
         case 5:
             switch ((s3d_tri->cmd_set >> 15) & 0x3) {
                 case 0:
-                    dest_pixel = dest_pixel_lit_texture_reflection;
+                    state.dest_pixel = dest_pixel_lit_texture_reflection;
                     break;
                 case 1:
-                    dest_pixel = dest_pixel_lit_texture_modulate;
+                    state.dest_pixel = dest_pixel_lit_texture_modulate;
                     break;
                 case 2:
-                    dest_pixel = dest_pixel_lit_texture_decal;
+                    state.dest_pixel = dest_pixel_lit_texture_decal;
                     break;
                 default:
                     return;
@@ -4405,7 +4438,7 @@ s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri)
             break;
         case 2:
         case 6:
-            dest_pixel = dest_pixel_unlit_texture_triangle;
+            state.dest_pixel = dest_pixel_unlit_texture_triangle;
             break;
         default:
             return;
@@ -4414,66 +4447,66 @@ s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri)
     switch (((s3d_tri->cmd_set >> 12) & 7) | ((s3d_tri->cmd_set & (1 << 29)) ? 8 : 0)) {
         case 0:
         case 1:
-            tex_sample = tex_sample_mipmap;
+            state.tex_sample = tex_sample_mipmap;
             break;
         case 2:
         case 3:
-            tex_sample = virge->bilinear_enabled ? tex_sample_mipmap_filter : tex_sample_mipmap;
+            state.tex_sample = virge->bilinear_enabled ? tex_sample_mipmap_filter : tex_sample_mipmap;
             break;
         case 4:
         case 5:
-            tex_sample = tex_sample_normal;
+            state.tex_sample = tex_sample_normal;
             break;
         case 6:
         case 7:
-            tex_sample = virge->bilinear_enabled ? tex_sample_normal_filter : tex_sample_normal;
+            state.tex_sample = virge->bilinear_enabled ? tex_sample_normal_filter : tex_sample_normal;
             break;
         case (0 | 8):
         case (1 | 8):
             if ((virge->chip == S3_VIRGEDX) || (virge->chip >= S3_VIRGEGX2))
-                tex_sample = tex_sample_persp_mipmap_375;
+                state.tex_sample = tex_sample_persp_mipmap_375;
             else
-                tex_sample = tex_sample_persp_mipmap;
+                state.tex_sample = tex_sample_persp_mipmap;
             break;
         case (2 | 8):
         case (3 | 8):
             if ((virge->chip == S3_VIRGEDX) || (virge->chip >= S3_VIRGEGX2))
-                tex_sample = virge->bilinear_enabled ? tex_sample_persp_mipmap_filter_375 :
+                state.tex_sample = virge->bilinear_enabled ? tex_sample_persp_mipmap_filter_375 :
                                                        tex_sample_persp_mipmap_375;
             else
-                tex_sample = virge->bilinear_enabled ? tex_sample_persp_mipmap_filter :
+                state.tex_sample = virge->bilinear_enabled ? tex_sample_persp_mipmap_filter :
                                                        tex_sample_persp_mipmap;
             break;
         case (4 | 8):
         case (5 | 8):
             if ((virge->chip == S3_VIRGEDX) || (virge->chip >= S3_VIRGEGX2))
-                tex_sample = tex_sample_persp_normal_375;
+                state.tex_sample = tex_sample_persp_normal_375;
             else
-                tex_sample = tex_sample_persp_normal;
+                state.tex_sample = tex_sample_persp_normal;
             break;
         case (6 | 8):
         case (7 | 8):
             if ((virge->chip == S3_VIRGEDX) || (virge->chip >= S3_VIRGEGX2))
-                tex_sample = virge->bilinear_enabled ? tex_sample_persp_normal_filter_375 :
+                state.tex_sample = virge->bilinear_enabled ? tex_sample_persp_normal_filter_375 :
                                                        tex_sample_persp_normal_375;
             else
-                tex_sample = virge->bilinear_enabled ? tex_sample_persp_normal_filter :
+                state.tex_sample = virge->bilinear_enabled ? tex_sample_persp_normal_filter :
                                                        tex_sample_persp_normal;
             break;
     }
 
     switch ((s3d_tri->cmd_set >> 5) & 7) {
         case 0:
-            tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB8888 : tex_ARGB8888_nowrap;
+            state.tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB8888 : tex_ARGB8888_nowrap;
             break;
         case 1:
-            tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB4444 : tex_ARGB4444_nowrap;
+            state.tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB4444 : tex_ARGB4444_nowrap;
             break;
         case 2:
-            tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB1555 : tex_ARGB1555_nowrap;
+            state.tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB1555 : tex_ARGB1555_nowrap;
             break;
         default:
-            tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB1555 : tex_ARGB1555_nowrap;
+            state.tex_read = (s3d_tri->cmd_set & CMD_SET_TWE) ? tex_ARGB1555 : tex_ARGB1555_nowrap;
             break;
     }
 
@@ -4484,47 +4517,64 @@ s3_virge_triangle(virge_t *virge, s3d_t *s3d_tri)
     state.x2 = s3d_tri->txend12;
     tri(virge, s3d_tri, &state, s3d_tri->ty12, s3d_tri->TdXdY02, s3d_tri->TdXdY12);
 
-    virge->tri_count++;
+    slot->pixel_count += state.pixel_count;
+    slot->tri_count++;
 
-    end_time = plat_timer_read();
+    if (!slot->index) {
+        end_time = plat_timer_read();
 
-    virge_time += end_time - start_time;
+        virge_time += end_time - start_time;
+    }
 }
 
 static void
 render_thread(void *param)
 {
-    virge_t *virge = (virge_t *) param;
+    struct virge_render_slot_t *slot  = (struct virge_render_slot_t *) param;
+    virge_t                    *virge = slot->virge;
+    int                         c     = slot->index;
 
     while (virge->render_thread_run) {
-        thread_wait_event(virge->wake_render_thread, -1);
-        thread_reset_event(virge->wake_render_thread);
-        virge->s3d_busy = 1;
-        while (!RB_EMPTY) {
-            s3_virge_triangle(virge, &virge->s3d_buffer[virge->s3d_read_idx & RB_MASK]);
-            virge->s3d_read_idx++;
-
-            if (RB_ENTRIES == RB_MASK)
-                thread_set_event(virge->not_full_event);
+        thread_wait_event(virge->wake_render_thread[c], -1);
+        thread_reset_event(virge->wake_render_thread[c]);
+        virge->s3d_busy[c] = 1;
+        while (!RB_EMPTY(c)) {
+            s3_virge_triangle(virge, &virge->s3d_buffer[virge->s3d_read_idx[c] & RB_MASK], slot);
+            virge->s3d_read_idx[c]++;
+
+            if (RB_ENTRIES(c) == RB_MASK)
+                thread_set_event(virge->not_full_event[c]);
         }
-        virge->s3d_busy = 0;
-        virge->subsys_stat |= INT_S3D_DONE;
-        virge->irq_pending++;
+
+        /*Only signal completion once the last thread has drawn its bands.
+          The mutex orders the idle checks so one of the threads always
+          sees the others finished.*/
+        thread_wait_mutex(virge->render_idle_mutex);
+        virge->s3d_busy[c] = 0;
+        if (!s3_virge_render_busy(virge)) {
+            virge->subsys_stat |= INT_S3D_DONE;
+            virge->irq_pending++;
+        }
+        thread_release_mutex(virge->render_idle_mutex);
     }
 }
 
 static void
 queue_triangle(virge_t *virge)
 {
-    if (RB_FULL) {
-        thread_reset_event(virge->not_full_event);
-        if (RB_FULL)
-            thread_wait_event(virge->not_full_event, -1); /*Wait for room in ringbuffer*/
+    for (int c = 0; c < virge->render_threads; c++) {
+        if (RB_FULL(c)) {
+            thread_reset_event(virge->not_full_event[c]);
+            if (RB_FULL(c))
+                thread_wait_event(virge->not_full_event[c], -1); /*Wait for room in ringbuffer*/
+        }
     }
     virge->s3d_buffer[virge->s3d_write_idx & RB_MASK] = virge->s3d_tri;
     virge->s3d_write_idx++;
-    if (!virge->s3d_busy)
-        thread_set_event(virge->wake_render_thread); /*Wake up render thread if moving from idle*/
+    for (int c = 0; c < virge->render_threads; c++) {
+        if (!virge->s3d_busy[c])
+            thread_set_event(virge->wake_render_thread[c]); /*Wake up render thread if moving from idle*/
+    }
 }
 
 static void
@@ -5314,9 +5364,11 @@ s3_virge_reset(void *priv)
         dev->virge_busy       = 0;
         dev->fifo_write_idx   = 0;
         dev->fifo_read_idx    = 0;
-        dev->s3d_busy         = 0;
         dev->s3d_write_idx    = 0;
-        dev->s3d_read_idx     = 0;
+        for (int c = 0; c < VIRGE_MAX_RENDER_THREADS; c++) {
+            dev->s3d_busy[c]     = 0;
+            dev->s3d_read_idx[c] = 0;
+        }
         reset_state->pci_slot = dev->pci_slot;
 
         *dev = *reset_state;
@@ -5334,6 +5386,11 @@ s3_virge_init(const device_t *info)
 
     virge->bilinear_enabled  = device_get_config_int("bilinear");
     virge->dithering_enabled = device_get_config_int("dithering");
+    virge->render_threads    = device_get_config_int("render_threads");
+    if (virge->render_threads < 1)
+        virge->render_threads = 1;
+    else if (virge->render_threads > VIRGE_MAX_RENDER_THREADS)
+        virge->render_threads = VIRGE_MAX_RENDER_THREADS;
     if (virge->type >= S3_VIRGE_GX2)
         virge->memory_size = 4;
     else if (virge->type == S3_VIRGE_325 && info->local & 0x100)
@@ -5408,11 +5465,13 @@ s3_virge_init(const device_t *info)
                     svga_readw_linear,
                     svga_readl_linear,
                     svga_write_linear,
-                    svga_writew_linear,
-                    svga_writel_linear,
+                    svga_writew_lfb,
+                    svga_writel_lfb,
                     NULL,
                     MEM_MAPPING_EXTERNAL,
                     &virge->svga);
+    mem_mapping_set_block_handler(&virge->linear_mapping, svga_read_block_linear, svga_write_block_linear);
+    virge->svga.direct_lfb = 1;
     mem_mapping_add(&virge->mmio_mapping, 0, 0,
                     s3_virge_mmio_read,
                     s3_virge_mmio_read_w,
@@ -5571,11 +5630,16 @@ s3_virge_init(const device_t *info)
 
     virge->svga.force_old_addr = 1;
 
-    virge->render_thread_run  = 1;
-    virge->wake_render_thread = thread_create_event();
-    virge->wake_main_thread   = thread_create_event();
-    virge->not_full_event     = thread_create_event();
-    virge->render_thread      = thread_create(render_thread, virge);
+    virge->render_thread_run = 1;
+    virge->wake_main_thread  = thread_create_event();
+    virge->render_idle_mutex = thread_create_mutex();
+    for (int c = 0; c < virge->render_threads; c++) {
+        virge->render_slot[c].virge  = virge;
+        virge->render_slot[c].index  = c;
+        virge->wake_render_thread[c] = thread_create_event();
+        virge->not_full_event[c]     = thread_create_event();
+        virge->render_thread[c]      = thread_create(render_thread, &virge->render_slot[c]);
+    }
 
     virge->fifo_thread_run     = 1;
     virge->wake_fifo_thread    = thread_create_event();
@@ -5597,11 +5661,14 @@ s3_virge_close(void *priv)
     virge_t *virge = (virge_t *) priv;
 
     virge->render_thread_run = 0;
-    thread_set_event(virge->wake_render_thread);
-    thread_wait(virge->render_thread);
-    thread_destroy_event(virge->not_full_event);
+    for (int c = 0; c < virge->render_threads; c++) {
+        thread_set_event(virge->wake_render_thread[c]);
+        thread_wait(virge->render_thread[c]);
+        thread_destroy_event(virge->not_full_event[c]);
+        thread_destroy_event(virge->wake_render_thread[c]);
+    }
+    thread_close_mutex(virge->render_idle_mutex);
     thread_destroy_event(virge->wake_main_thread);
-    thread_destroy_event(virge->wake_render_thread);
 
     virge->fifo_thread_run = 0;
     thread_set_event(virge->wake_fifo_thread);
@@ -5702,6 +5769,27 @@ s3_virge_force_redraw(void *priv)
     virge->svga.fullchange = changeframecount;
 }
 
+#define S3_VIRGE_RENDER_THREADS_CONFIG          \
+    {                                           \
+        .name           = "render_threads",     \
+        .description    = "Render threads",     \
+        .type           = CONFIG_SELECTION,     \
+        .default_string = NULL,                 \
+        .default_int    = 2,                    \
+        .file_filter    = NULL,                 \
+        .spinner        = { 0 },                \
+        .selection      = {                     \
+            { .description = "1", .value = 1 }, \
+            { .description = "2", .value = 2 }, \
+            { .description = "3", .value = 3 }, \
+            { .description = "4", .value = 4 }, \
+            { .description = "6", .value = 6 }, \
+            { .description = "8", .value = 8 }, \
+            { .description = ""              }  \
+        },                                      \
+        .bios           = { { 0 } }             \
+    }
+
 static const device_config_t s3_virge_config[] = {
     // clang-format off
     {
@@ -5749,6 +5837,7 @@ static const device_config_t s3_virge_config[] = {
         .selection      = { { 0 } },
         .bios           = { { 0 } }
     },
+    S3_VIRGE_RENDER_THREADS_CONFIG,
     { .name = "", .description = "", .type = CONFIG_END }
     // clang-format on
 };
@@ -5786,6 +5875,7 @@ static const device_config_t s3_virge_onboard_config[] = {
         .selection      = { { 0 } },
         .bios           = { { 0 } }
     },
+    S3_VIRGE_RENDER_THREADS_CONFIG,
     { .name = "", .description = "", .type = CONFIG_END }
     // clang-format on
 };
@@ -5838,6 +5928,7 @@ static const device_config_t s3_virge_stb_config[] = {
         .selection      = { { 0 } },
         .bios           = { { 0 } }
     },
+    S3_VIRGE_RENDER_THREADS_CONFIG,
     { .name = "", .description = "", .type = CONFIG_END }
     // clang-format on
 };
@@ -5891,6 +5982,7 @@ static const device_config_t s3_virge_357_config[] = {
         .selection      = { { 0 } },
         .bios           = { { 0 } }
     },
+    S3_VIRGE_RENDER_THREADS_CONFIG,
     { .name = "", .description = "", .type = CONFIG_END }
     // clang-format on
 };
@@ -5945,6 +6037,7 @@ static const device_config_t s3_trio3d2x_config[] = {
         .selection      = { { 0 } },
         .bios           = { { 0 } }
     },
+    S3_VIRGE_RENDER_THREADS_CONFIG,
     { .name = "", .description = "", .type = CONFIG_END }
     // clang-format on
 };
@@ -18,7 +18,9 @@
  *          Copyright 2016-2019 Miran Grca.
  */
 #include <inttypes.h>
+#include <limits.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -35,6 +37,7 @@
 #include <86box/mem.h>
 #include <86box/rom.h>
 #include <86box/plat.h>
+#include <86box/thread.h>
 #include <86box/ui.h>
 #include <86box/video.h>
 #include <86box/vid_8514a.h>
@@ -46,6 +49,9 @@
 void svga_doblit(int wx, int wy, svga_t *svga);
 void svga_poll(void *priv);
 
+static void svga_pipeline_sync(svga_t *svga);
+static void svga_pipeline_palette(svga_t *svga, int index);
+
 svga_t *svga_8514;
 
 extern int     cyc_total;
@@ -100,6 +106,9 @@ svga_set_override(svga_t *svga, int val)
     if (svga->override && !val)
         svga->fullchange = svga->monitor->mon_changeframecount;
 
+    /* Queued lines must not land on top of the other device's output. */
+    svga_pipeline_sync(svga);
+
     svga->override = val;
 
     svga_log("Override=%x.\n", val);
@@ -236,6 +245,7 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                     svga_recalctimings(svga);
                 }
             } else {
+                svga->render_resync |= SVGA_RESYNC_STATE;
                 if ((svga->attraddr == 0x13) && (svga->attrregs[0x13] != val))
                     svga->fullchange = svga->monitor->mon_changeframecount;
                 o                                   = svga->attrregs[svga->attraddr & 0x1f];
@@ -300,6 +310,8 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
         case 0x3c5:
             if (svga->seqaddr > 0xf)
                 return;
+            if (svga->direct_lfb)
+                mem_flush_write_direct();
             o                                  = svga->seqregs[svga->seqaddr & 0xf];
             svga->seqregs[svga->seqaddr & 0xf] = val;
             if (o != val && (svga->seqaddr & 0xf) == 1) {
@@ -318,6 +330,7 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                     svga->writemask = val & 0xf;
                     break;
                 case 3:
+                    svga->render_resync |= SVGA_RESYNC_STATE;
                     svga->charsetb = (((val >> 2) & 3) * 0x10000) + 2;
                     svga->charseta = ((val & 3) * 0x10000) + 2;
                     if (val & 0x10)
@@ -326,6 +339,7 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                         svga->charsetb += 0x8000;
                     break;
                 case 4:
+                    svga->render_resync |= SVGA_RESYNC_STATE;
                     svga->chain2_write = !(val & 4);
                     svga->chain4       = (svga->chain4 & ~8) | (val & 8);
                     svga->fast         = (svga->gdcreg[8] == 0xff && !(svga->gdcreg[3] & 0x18) && !svga->gdcreg[1]) &&
@@ -338,6 +352,8 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
             }
             break;
         case 0x3c6:
+            if (svga->dac_mask != val)
+                svga->render_resync |= SVGA_RESYNC_STATE;
             svga->dac_mask = val;
             break;
         case 0x3c7:
@@ -369,6 +385,7 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                         svga->pallook[index] = makecol32(svga->vgapal[index].r, svga->vgapal[index].g, svga->vgapal[index].b);
                     else
                         svga->pallook[index] = makecol32(video_6to8[svga->vgapal[index].r & 0x3f], video_6to8[svga->vgapal[index].g & 0x3f], video_6to8[svga->vgapal[index].b & 0x3f]);
+                    svga_pipeline_palette(svga, index);
                     svga->dac_pos  = 0;
                     svga->dac_addr = (svga->dac_addr + 1) & 0xff;
                     break;
@@ -381,6 +398,8 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
             svga->gdcaddr = val;
             break;
         case 0x3cf:
+            if (svga->direct_lfb)
+                mem_flush_write_direct();
             o = svga->gdcreg[svga->gdcaddr & 15];
             switch (svga->gdcaddr & 15) {
                 case 2:
@@ -709,6 +728,9 @@ svga_recalctimings(svga_t *svga)
     int              old_monitor_overscan_x = svga->monitor->mon_overscan_x;
     int              old_monitor_overscan_y = svga->monitor->mon_overscan_y;
 
+    if (svga->direct_lfb)
+        mem_flush_write_direct();
+
     if (svga->adv_flags & FLAG_PRECISETIME) {
 #ifdef USE_DYNAREC
         if (cpu_use_dynarec)
@@ -1215,6 +1237,7 @@ svga_recalctimings(svga_t *svga)
             int x_add   = enable_overscan ? svga->monitor->mon_overscan_x : 0;
             int y_start = enable_overscan ? 0 : (svga->monitor->mon_overscan_y >> 1);
             int x_start = enable_overscan ? 0 : (svga->monitor->mon_overscan_x >> 1);
+            svga_pipeline_sync(svga);
             video_wait_for_buffer_monitor(svga->monitor_index);
             memset(svga->monitor->target_buffer->dat, 0, (size_t) svga->monitor->target_buffer->w * svga->monitor->target_buffer->h * 4);
             video_blit_memtoscreen_monitor(x_start, y_start, svga->monitor->mon_xsize + x_add, svga->monitor->mon_ysize + y_add, svga->monitor_index);
@@ -1223,7 +1246,8 @@ svga_recalctimings(svga_t *svga)
             ui_sb_set_text_w(plat_get_string(STRING_MONITOR_SLEEP));
         }
     } else if (svga->dpms_ui) {
-        svga->dpms_ui = 0;
+        svga->dpms_ui    = 0;
+        svga->fullchange = svga->monitor->mon_changeframecount;
         ui_sb_set_text_w(NULL);
     }
 
@@ -1280,53 +1304,381 @@ svga_recalctimings(svga_t *svga)
                 break;
         }
     }
+
+    svga->render_resync |= SVGA_RESYNC_STATE;
 }
 
+/* Draws the current line into the target buffer: the mode's renderer, the
+   overlay and hardware cursors on top of it, then the borders. The render
+   thread only gets lines without overlay or cursors. */
 static void
-svga_do_render(svga_t *svga)
+svga_render_line(svga_t *svga)
 {
+    int last;
+
     /* Always render a blank screen and nothing else while in DPMS mode. */
     if (svga->dpms) {
         svga_render_blank(svga);
         return;
     }
 
-    if (!svga->override) {
+    /* The renderers skip lines whose pages did not change and set
+       lastline_draw only when they draw, which tells which rows are dirty. */
+    last                = svga->lastline_draw;
+    svga->lastline_draw = -1;
+
+    svga->render(svga);
+
+    if (svga->lastline_draw == -1)
+        svga->lastline_draw = last;
+    else {
+        const int row = svga->displine + svga->y_add;
+
+        if (row < svga->dirty_y1)
+            svga->dirty_y1 = row;
+        if (row >= svga->dirty_y2)
+            svga->dirty_y2 = row + 1;
+    }
+
+    if (svga->overlay_on && svga->overlay_draw)
+        svga->overlay_draw(svga, svga->displine + svga->y_add);
+
+    if (svga->dac_hwcursor_on && svga->dac_hwcursor_draw)
+        svga->dac_hwcursor_draw(svga, (svga->displine + svga->y_add + ((svga->dac_hwcursor_latch.y >= 0) ? 0 : svga->dac_hwcursor_latch.y)) & 2047);
+
+    if (svga->hwcursor_on && svga->hwcursor_draw)
+        svga->hwcursor_draw(svga, (svga->displine + svga->y_add + ((svga->hwcursor_latch.y >= 0) ? 0 : svga->hwcursor_latch.y)) & 2047);
+
+    svga->x_add = svga->left_overscan;
+    svga_render_overscan_left(svga);
+    svga_render_overscan_right(svga);
+    svga->x_add = svga->left_overscan - svga->scrollcache;
+}
+
+/*
+   Optional scanline render thread (video_render_thread), one per SVGA
+   device, whichever monitor it drives. Every monitor is still polled on
+   the emulation thread, and MDA, Hercules, CGA, 8514/A and XGA output is
+   drawn there too; only the blit runs on a per-monitor thread.
+
+   svga_poll() only records the few fields that change from one line to the
+   next and queues them; the thread draws each line against its own copy of
+   the rest of svga_t. DAC writes are queued in between the lines and applied
+   to that copy in order, so palette cycling costs no more than the line
+   itself. The copy is refreshed wholesale, with the queue drained first,
+   before the first line of every frame and before the first line after a
+   write to a register the renderers read (attribute controller, character
+   maps, chain 4, DAC mask, or anything that goes through
+   svga_recalctimings()). Writes that bypass svga_out() and
+   svga_recalctimings() are picked up by the next frame at the latest.
+
+   Lines with the overlay or a hardware cursor on are drawn inline after
+   draining the queue, as the card's draw callbacks read and step live card
+   state.
+
+   The queue is drained again at the end of the active display, before the
+   changedvram countdown and the blit, so the thread never falls more than
+   one frame behind the emulated CRTC.
+ */
+#define SVGA_PIPELINE_SIZE 256
+#define SVGA_PIPELINE_MASK (SVGA_PIPELINE_SIZE - 1)
+
+#define SVGA_QUEUE_LINE    0
+#define SVGA_QUEUE_PALETTE 1
+
+typedef struct svga_line_t {
+    uint8_t  type;
+    uint8_t  dpms;
+
+    /* SVGA_QUEUE_PALETTE: one DAC entry. */
+    uint8_t  pal_index;
+    rgb_t    pal_rgb;
+    uint32_t pal_col;
+
+    uint32_t memaddr;
+    int      displine;
+    int      y_add;
+    int      x_add;
+    int      scrollcache;
+    int      half_pixel;
+    int      render_line_offset;
+    int      scanline;
+    int      linecountff;
+    int      cursorvisible;
+} svga_line_t;
+
+typedef struct svga_pipeline_t {
+    svga_t      svga;
+    svga_line_t lines[SVGA_PIPELINE_SIZE];
+
+    atomic_uint read_idx;
+    atomic_uint write_idx;
+    atomic_int  thread_run;
+    int         monitor_index;
+
+    thread_t *thread;
+    event_t  *wake_event;
+    event_t  *idle_event;
+} svga_pipeline_t;
+
+static void
+svga_pipeline_thread(void *priv)
+{
+    svga_pipeline_t   *pl   = (svga_pipeline_t *) priv;
+    svga_t            *svga = &pl->svga;
+    const svga_line_t *line;
+    unsigned int       read_idx;
+
+    pc_thread_setup(THREAD_ROLE_BLIT);
+
+    /* Cursor and overlay routines that go through buffer32 must land on
+       this device's monitor. */
+    monitor_index_global = pl->monitor_index;
+
+    while (atomic_load(&pl->thread_run)) {
+        read_idx = atomic_load(&pl->read_idx);
+        if (read_idx == atomic_load(&pl->write_idx)) {
+            thread_wait_event(pl->wake_event, -1);
+            thread_reset_event(pl->wake_event);
+            continue;
+        }
+
+        line = &pl->lines[read_idx & SVGA_PIPELINE_MASK];
+
+        if (line->type == SVGA_QUEUE_PALETTE) {
+            svga->vgapal[line->pal_index]  = line->pal_rgb;
+            svga->pallook[line->pal_index] = line->pal_col;
+        } else {
+            svga->memaddr            = line->memaddr;
+            svga->displine           = line->displine;
+            svga->y_add              = line->y_add;
+            svga->x_add              = line->x_add;
+            svga->scrollcache        = line->scrollcache;
+            svga->half_pixel         = line->half_pixel;
+            svga->render_line_offset = line->render_line_offset;
+            svga->scanline           = line->scanline;
+            svga->linecountff        = line->linecountff;
+            svga->cursorvisible      = line->cursorvisible;
+            svga->dpms               = line->dpms;
+
+            svga_render_line(svga);
+        }
+
+        atomic_store(&pl->read_idx, read_idx + 1);
+        if ((read_idx + 1) == atomic_load(&pl->write_idx))
+            thread_set_event(pl->idle_event);
+    }
+}
+
+/* Waits for every queued line to be drawn and hands the rows they dirtied
+   back to the emulation side. */
+static void
+svga_pipeline_sync(svga_t *svga)
+{
+    svga_pipeline_t *pl = svga->pipeline;
+
+    if (!pl)
+        return;
+
+    while (atomic_load(&pl->read_idx) != atomic_load(&pl->write_idx)) {
+        thread_reset_event(pl->idle_event);
+        if (atomic_load(&pl->read_idx) != atomic_load(&pl->write_idx))
+            thread_wait_event(pl->idle_event, -1);
+    }
+
+    if (pl->svga.dirty_y1 < svga->dirty_y1)
+        svga->dirty_y1 = pl->svga.dirty_y1;
+    if (pl->svga.dirty_y2 > svga->dirty_y2)
+        svga->dirty_y2 = pl->svga.dirty_y2;
+    pl->svga.dirty_y1 = INT_MAX;
+    pl->svga.dirty_y2 = 0;
+}
+
+static void
+svga_pipeline_resync(svga_t *svga)
+{
+    svga_pipeline_t *pl = svga->pipeline;
+    svga_t          *r  = &pl->svga;
+
+    svga_pipeline_sync(svga);
+
+    memcpy(r, svga, sizeof(svga_t));
+
+    if (svga->map8 == svga->pallook)
+        r->map8 = r->pallook;
+    r->pipeline        = NULL;
+    r->hwcursor_on     = 0;
+    r->dac_hwcursor_on = 0;
+    r->overlay_on      = 0;
+    r->dirty_y1        = INT_MAX;
+    r->dirty_y2        = 0;
+
+    svga->render_resync = 0;
+}
+
+/* Next free queue entry, draining the queue if it is full. */
+static svga_line_t *
+svga_pipeline_slot(svga_t *svga, unsigned int *write_idx)
+{
+    svga_pipeline_t *pl = svga->pipeline;
+
+    *write_idx = atomic_load(&pl->write_idx);
+    if ((*write_idx - atomic_load(&pl->read_idx)) >= SVGA_PIPELINE_SIZE)
+        svga_pipeline_sync(svga);
+
+    return &pl->lines[*write_idx & SVGA_PIPELINE_MASK];
+}
+
+static void
+svga_pipeline_push(svga_t *svga, unsigned int write_idx)
+{
+    svga_pipeline_t *pl = svga->pipeline;
+
+    atomic_store(&pl->write_idx, write_idx + 1);
+
+    /* The thread only sleeps on an empty queue. */
+    if (write_idx == atomic_load(&pl->read_idx))
+        thread_set_event(pl->wake_event);
+}
+
+/* A DAC entry was written: queue it behind the lines already drawn with the
+   old colour. A pending full refresh picks it up anyway. */
+static void
+svga_pipeline_palette(svga_t *svga, int index)
+{
+    svga_line_t *line;
+    unsigned int write_idx;
+
+    if (!svga->pipeline || svga->render_resync)
+        return;
+
+    line = svga_pipeline_slot(svga, &write_idx);
+
+    line->type      = SVGA_QUEUE_PALETTE;
+    line->pal_index = index;
+    line->pal_rgb   = svga->vgapal[index];
+    line->pal_col   = svga->pallook[index];
+
+    svga_pipeline_push(svga, write_idx);
+}
+
+static void
+svga_pipeline_queue(svga_t *svga)
+{
+    svga_line_t *line;
+    unsigned int write_idx;
+
+    if (svga->render_resync)
+        svga_pipeline_resync(svga);
+
+    line = svga_pipeline_slot(svga, &write_idx);
+
+    line->type                 = SVGA_QUEUE_LINE;
+    line->memaddr              = svga->memaddr;
+    line->displine             = svga->displine;
+    line->y_add                = svga->y_add;
+    line->x_add                = svga->x_add;
+    line->scrollcache          = svga->scrollcache;
+    line->half_pixel           = svga->half_pixel;
+    line->render_line_offset   = svga->render_line_offset;
+    line->scanline             = svga->scanline;
+    line->linecountff          = svga->linecountff;
+    line->cursorvisible        = svga->cursorvisible;
+    line->dpms                 = svga->dpms;
+
+    svga_pipeline_push(svga, write_idx);
+}
+
+static void
+svga_pipeline_init(svga_t *svga)
+{
+    svga_pipeline_t *pl = calloc(1, sizeof(svga_pipeline_t));
+
+    atomic_init(&pl->read_idx, 0);
+    atomic_init(&pl->write_idx, 0);
+    atomic_init(&pl->thread_run, 1);
+    pl->monitor_index = svga->monitor_index;
+
+    pl->wake_event = thread_create_event();
+    pl->idle_event = thread_create_event();
+
+    svga->pipeline      = pl;
+    svga->render_resync = SVGA_RESYNC_FRAME;
+
+    pl->thread = thread_create(svga_pipeline_thread, pl);
+}
+
+static void
+svga_pipeline_close(svga_t *svga)
+{
+    svga_pipeline_t *pl = svga->pipeline;
+
+    if (!pl)
+        return;
+
+    svga_pipeline_sync(svga);
+
+    atomic_store(&pl->thread_run, 0);
+    thread_set_event(pl->wake_event);
+    thread_wait(pl->thread);
+
+    thread_destroy_event(pl->wake_event);
+    thread_destroy_event(pl->idle_event);
+
+    free(pl);
+    svga->pipeline = NULL;
+}
+
+/* Draws the current line, or queues it for the render thread. */
+static void
+svga_render_submit(svga_t *svga)
+{
+    /* A parent device drawing in its own way, and the overlay and cursor
+       callbacks, read the live state. */
+    if (svga->pipeline && !svga->render_override && !svga->overlay_on &&
+        !svga->hwcursor_on && !svga->dac_hwcursor_on)
+        svga_pipeline_queue(svga);
+    else {
+        svga_pipeline_sync(svga);
+        svga_render_line(svga);
+    }
+}
+
+static void
+svga_do_render(svga_t *svga)
+{
+    /* Skipped frames only keep the cursor and overlay line counts going. */
+    const int draw = !svga->override && !svga->frame_skip;
+
+    if (svga->dpms) {
+        if (!svga->frame_skip)
+            svga_render_submit(svga);
+        return;
+    }
+
+    if (draw) {
         svga->render_line_offset = svga->start_retrace_latch - svga->crtc[0x4];
-        svga->render(svga);
+        svga_render_submit(svga);
+        svga->x_add = svga->left_overscan - svga->scrollcache;
     }
 
     if (svga->overlay_on) {
-        if (!svga->override && svga->overlay_draw)
-            svga->overlay_draw(svga, svga->displine + svga->y_add);
         svga->overlay_on--;
         if (svga->overlay_on && svga->interlace)
             svga->overlay_on--;
     }
 
     if (svga->dac_hwcursor_on) {
-        if (!svga->override && svga->dac_hwcursor_draw)
-            svga->dac_hwcursor_draw(svga, (svga->displine + svga->y_add + ((svga->dac_hwcursor_latch.y >= 0) ? 0 : svga->dac_hwcursor_latch.y)) & 2047);
         svga->dac_hwcursor_on--;
         if (svga->dac_hwcursor_on && svga->interlace)
             svga->dac_hwcursor_on--;
     }
 
     if (svga->hwcursor_on) {
-        if (!svga->override && svga->hwcursor_draw)
-            svga->hwcursor_draw(svga, (svga->displine + svga->y_add + ((svga->hwcursor_latch.y >= 0) ? 0 : svga->hwcursor_latch.y)) & 2047);
-
         svga->hwcursor_on--;
         if (svga->hwcursor_on && svga->interlace)
             svga->hwcursor_on--;
     }
-
-    if (!svga->override) {
-        svga->x_add = svga->left_overscan;
-        svga_render_overscan_left(svga);
-        svga_render_overscan_right(svga);
-        svga->x_add = svga->left_overscan - svga->scrollcache;
-    }
 }
 
 void
@@ -1382,7 +1734,8 @@ svga_poll(void *priv)
             svga->memaddr &= svga->vram_display_mask;
             if (svga->firstline == 2000) {
                 svga->firstline = svga->displine;
-                video_wait_for_buffer_monitor(svga->monitor_index);
+                if (!svga->frame_skip)
+                    video_wait_for_buffer_monitor(svga->monitor_index);
             }
 
             if (svga->hwcursor_on || svga->dac_hwcursor_on || svga->overlay_on)
@@ -1524,6 +1877,8 @@ svga_poll(void *priv)
             }
         }
         if (svga->vc == svga->dispend) {
+            svga_pipeline_sync(svga);
+
             if (svga->vblank_start)
                 svga->vblank_start(svga);
 
@@ -1541,15 +1896,20 @@ svga_poll(void *priv)
 
             svga->blink = (svga->blink + 1) & 0x7f;
 
-            for (x = 0; x < ((svga->vram_mask + 1) >> 12); x++) {
-                if (svga->changedvram[x])
-                    svga->changedvram[x]--;
-            }
+            /* Changes made during a skipped frame have not been drawn yet. */
+            if (!svga->frame_skip) {
+                for (x = 0; x < ((svga->vram_mask + 1) >> 12); x++) {
+                    if (svga->changedvram[x])
+                        svga->changedvram[x]--;
+                }
 
-            if (svga->fullchange)
-                svga->fullchange--;
+                if (svga->fullchange)
+                    svga->fullchange--;
+            }
         }
         if (svga->vc == svga->vsyncstart) {
+            svga_pipeline_sync(svga);
+
             svga->dispon = 0;
             svga->cgastat |= 8;
             x = svga->hdisp;
@@ -1565,11 +1925,13 @@ svga_poll(void *priv)
                 if (svga->vertical_linedbl) {
                     wy = (svga->lastline - svga->firstline) << 1;
                     svga->vdisp = wy + 1;
-                    svga_doblit(wx, wy, svga);
+                    if (!svga->frame_skip)
+                        svga_doblit(wx, wy, svga);
                 } else {
                     wy = svga->lastline - svga->firstline;
                     svga->vdisp = wy + 1;
-                    svga_doblit(wx, wy, svga);
+                    if (!svga->frame_skip)
+                        svga_doblit(wx, wy, svga);
                 }
             }
 
@@ -1583,6 +1945,12 @@ svga_poll(void *priv)
 
             svga->monitor->mon_changeframecount = svga->interlace ? 3 : 2;
             svga->vslines                       = 0;
+            svga->frame_skip                    = video_skip_frame(svga->monitor_index);
+
+            /* Pages written directly stop being marked in changedvram, so
+               make the next write to each of them fault back in. */
+            if (svga->direct_lfb)
+                mem_flush_write_direct();
 
             if (svga->interlace && svga->oddeven)
                 svga->memaddr = svga->memaddr_backup = svga->memaddr_latch + (svga->rowoffset << 1) + svga->hblank_sub;
@@ -1653,6 +2021,8 @@ svga_poll(void *priv)
 
             svga->overlay_on    = 0;
             svga->overlay_latch = svga->overlay;
+
+            svga->render_resync |= SVGA_RESYNC_FRAME;
         }
         if (svga->scanline == (svga->crtc[10] & 31))
             svga->cursorvisible = 1;
@@ -1699,6 +2069,9 @@ svga_init(const device_t *info, svga_t *svga, void *priv, int memsize,
     svga->vram_display_mask = svga->vram_mask = memsize - 1;
     svga->decode_mask                         = 0x7fffff;
     svga->changedvram                         = calloc((memsize >> 12) + 1, 1);
+    svga->glyph_cache                         = calloc(1, sizeof(glyph_cache_t));
+    svga->dirty_y1                            = INT_MAX;
+    svga->dirty_y2                            = 0;
     svga->recalctimings_ex                    = recalctimings_ex;
     svga->video_in                            = video_in;
     svga->video_out                           = video_out;
@@ -1731,6 +2104,7 @@ svga_init(const device_t *info, svga_t *svga, void *priv, int memsize,
                         svga_read, svga_readw, svga_readl,
                         svga_write, svga_writew, svga_writel,
                         NULL, MEM_MAPPING_EXTERNAL, svga);
+        mem_mapping_set_block_handler(&svga->mapping, svga_read_block, svga_write_block);
     /* The chances of ever seeing a C-BUS (S)VGA card are approximately zero, but you never know. */
     } else if ((info->flags & DEVICE_CBUS) || (info->flags & DEVICE_ISA16)) {
         svga->read = svga_read;
@@ -1764,12 +2138,18 @@ svga_init(const device_t *info, svga_t *svga, void *priv, int memsize,
 
     svga->map8            = svga->pallook;
 
+    if (video_render_thread)
+        svga_pipeline_init(svga);
+
     return 0;
 }
 
 void
 svga_close(svga_t *svga)
 {
+    svga_pipeline_close(svga);
+
+    free(svga->glyph_cache);
     free(svga->changedvram);
     free(svga->vram);
 
@@ -1816,6 +2196,142 @@ svga_decode_addr(svga_t *svga, uint32_t addr, int write)
     return addr;
 }
 
+/* One byte per plane for each 4-bit plane mask, so the planar write
+   handlers below can work on all four planes at once. */
+static const uint32_t svga_plane_mask[16] = {
+    0x00000000, 0x000000ff, 0x0000ff00, 0x0000ffff,
+    0x00ff0000, 0x00ff00ff, 0x00ffff00, 0x00ffffff,
+    0xff000000, 0xff0000ff, 0xff00ff00, 0xff00ffff,
+    0xffff0000, 0xffff00ff, 0xffffff00, 0xffffffff
+};
+
+#define SVGA_ROP_SET(vall, bm, latch) (((vall) & (bm)) | ((latch) & ~(bm)))
+#define SVGA_ROP_AND(vall, bm, latch) (((vall) | ~(bm)) & (latch))
+#define SVGA_ROP_OR(vall, bm, latch)  (((vall) & (bm)) | (latch))
+#define SVGA_ROP_XOR(vall, bm, latch) (((vall) & (bm)) ^ (latch))
+
+static __inline uint8_t
+svga_write_rotate(svga_t *svga, uint8_t val)
+{
+    return (uint8_t) ((val >> (svga->gdcreg[3] & 7)) | (val << (8 - (svga->gdcreg[3] & 7))));
+}
+
+static __inline void
+svga_write_planes_store(svga_t *svga, uint32_t addr, uint32_t dat, int writemask2)
+{
+    const uint32_t wm = svga_plane_mask[writemask2 & 0x0f];
+    uint32_t      *p  = (uint32_t *) &svga->vram[addr];
+
+    *p = (*p & ~wm) | (dat & wm);
+}
+
+/* Write mode 0 with all bits enabled, the Set operation and no set/reset. */
+static void
+svga_write_planes_mode0_plain(svga_t *svga, uint32_t addr, uint8_t val, int writemask2)
+{
+    svga_write_planes_store(svga, addr, svga_write_rotate(svga, val) * 0x01010101, writemask2);
+}
+
+static void
+svga_write_planes_mode1(svga_t *svga, uint32_t addr, UNUSED(uint8_t val), int writemask2)
+{
+    svga_write_planes_store(svga, addr, svga->latch.d[0], writemask2);
+}
+
+#define SVGA_WRITE_PLANES(name, rop)                                                                  \
+    static void                                                                                       \
+    svga_write_planes_mode0_##name(svga_t *svga, uint32_t addr, uint8_t val, int writemask2)          \
+    {                                                                                                 \
+        const uint32_t sr   = svga_plane_mask[svga->gdcreg[1] & 0x0f];                                \
+        const uint32_t bm   = svga->gdcreg[8] * 0x01010101;                                           \
+        const uint32_t vall = ((svga_write_rotate(svga, val) * 0x01010101) & ~sr) |                   \
+                              (svga_plane_mask[svga->gdcreg[0] & 0x0f] & sr);                         \
+                                                                                                      \
+        svga_write_planes_store(svga, addr, rop(vall, bm, svga->latch.d[0]), writemask2);             \
+    }                                                                                                 \
+                                                                                                      \
+    static void                                                                                       \
+    svga_write_planes_mode2_##name(svga_t *svga, uint32_t addr, uint8_t val, int writemask2)          \
+    {                                                                                                 \
+        const uint32_t bm   = svga->gdcreg[8] * 0x01010101;                                           \
+        const uint32_t vall = svga_plane_mask[val & 0x0f];                                            \
+                                                                                                      \
+        svga_write_planes_store(svga, addr, rop(vall, bm, svga->latch.d[0]), writemask2);             \
+    }                                                                                                 \
+                                                                                                      \
+    static void                                                                                       \
+    svga_write_planes_mode3_##name(svga_t *svga, uint32_t addr, uint8_t val, int writemask2)          \
+    {                                                                                                 \
+        const uint32_t bm   = (svga->gdcreg[8] & svga_write_rotate(svga, val)) * 0x01010101;          \
+        const uint32_t vall = svga_plane_mask[svga->gdcreg[0] & 0x0f];                                \
+                                                                                                      \
+        svga_write_planes_store(svga, addr, rop(vall, bm, svga->latch.d[0]), writemask2);             \
+    }
+
+SVGA_WRITE_PLANES(set, SVGA_ROP_SET)
+SVGA_WRITE_PLANES(and, SVGA_ROP_AND)
+SVGA_WRITE_PLANES(or, SVGA_ROP_OR)
+SVGA_WRITE_PLANES(xor, SVGA_ROP_XOR)
+
+/* [write mode 0, 2, 3][logical operation] */
+static void (*const svga_write_planes_funcs[3][4])(svga_t *svga, uint32_t addr, uint8_t val, int writemask2) = {
+    { svga_write_planes_mode0_set, svga_write_planes_mode0_and, svga_write_planes_mode0_or, svga_write_planes_mode0_xor },
+    { svga_write_planes_mode2_set, svga_write_planes_mode2_and, svga_write_planes_mode2_or, svga_write_planes_mode2_xor },
+    { svga_write_planes_mode3_set, svga_write_planes_mode3_and, svga_write_planes_mode3_or, svga_write_planes_mode3_xor }
+};
+
+/* Everything the choice of planar write handler depends on. Cards change
+   these registers in many places of their own, so the key is compared on
+   every write rather than relying on each of them to reselect. */
+static __inline uint32_t
+svga_write_planes_key(const svga_t *svga)
+{
+    return 0x80000000 | svga->writemode | (svga->gdcreg[3] & 0x18) |
+           ((svga->gdcreg[8] == 0xff) << 5) |
+           ((svga->gdcreg[1] && !svga->set_reset_disabled) << 6) |
+           (!!(svga->adv_flags & FLAG_LATCH8) << 7) |
+           (((svga->adv_flags & (FLAG_EXT_WRITE | FLAG_ADDR_BY8)) == (FLAG_EXT_WRITE | FLAG_ADDR_BY8)) << 8) |
+           ((svga->translate_address != NULL) << 9);
+}
+
+static void
+svga_write_planes_select(svga_t *svga, uint32_t key)
+{
+    const int rop = (svga->gdcreg[3] >> 3) & 3;
+
+    svga->write_planes_key = key;
+
+    /* Eight latches, reversed plane bits and translated (possibly
+       unaligned) addresses are left to svga_write_common(). */
+    if ((svga->adv_flags & FLAG_LATCH8) ||
+        ((svga->adv_flags & FLAG_EXT_WRITE) && (svga->adv_flags & FLAG_ADDR_BY8)) ||
+        svga->translate_address) {
+        svga->write_planes = NULL;
+        return;
+    }
+
+    switch (svga->writemode) {
+        case 0:
+            if ((svga->gdcreg[8] == 0xff) && !rop && (!svga->gdcreg[1] || svga->set_reset_disabled))
+                svga->write_planes = svga_write_planes_mode0_plain;
+            else
+                svga->write_planes = svga_write_planes_funcs[0][rop];
+            break;
+        case 1:
+            svga->write_planes = svga_write_planes_mode1;
+            break;
+        case 2:
+            svga->write_planes = svga_write_planes_funcs[1][rop];
+            break;
+        case 3:
+            svga->write_planes = svga_write_planes_funcs[2][rop];
+            break;
+        default:
+            svga->write_planes = NULL;
+            break;
+    }
+}
+
 static __inline void
 svga_write_common(uint32_t addr, uint8_t val, uint8_t linear, void *priv)
 {
@@ -1826,6 +2342,7 @@ svga_write_common(uint32_t addr, uint8_t val, uint8_t linear, void *priv)
     uint8_t wm         = svga->writemask;
     uint8_t count;
     uint8_t i;
+    uint32_t key;
 
     if (svga->adv_flags & FLAG_ADDR_BY8)
         writemask2 = svga->seqregs[2];
@@ -1877,6 +2394,14 @@ svga_write_common(uint32_t addr, uint8_t val, uint8_t linear, void *priv)
 
     svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
 
+    key = svga_write_planes_key(svga);
+    if (key != svga->write_planes_key)
+        svga_write_planes_select(svga, key);
+    if (svga->write_planes) {
+        svga->write_planes(svga, addr, val, writemask2);
+        return;
+    }
+
     count = 4;
     if (svga->adv_flags & FLAG_LATCH8)
         count = 8;
@@ -2125,6 +2650,23 @@ svga_read_linear(uint32_t addr, void *priv)
     return svga_read_common(addr, 1, priv);
 }
 
+/* Whether the frame comes from a renderer other than svga_render_line(). */
+static int
+svga_foreign_render(svga_t *svga)
+{
+    const ibm8514_t *dev = (ibm8514_t *) svga->dev8514;
+    const xga_t     *xga = (xga_t *) svga->xga;
+
+    if (svga->override)
+        return 1;
+    if (ibm8514_active && (dev != NULL) && dev->on)
+        return 1;
+    if (xga_active && (xga != NULL) && xga->on)
+        return 1;
+
+    return 0;
+}
+
 void
 svga_doblit(int wx, int wy, svga_t *svga)
 {
@@ -2138,6 +2680,8 @@ svga_doblit(int wx, int wy, svga_t *svga)
     int       j;
     int       xs_temp;
     int       ys_temp;
+    int       resized = 0;
+    uint32_t  border;
 
     y_add   = enable_overscan ? svga->monitor->mon_overscan_y : 0;
     x_add   = enable_overscan ? svga->monitor->mon_overscan_x : 0;
@@ -2174,6 +2718,7 @@ svga_doblit(int wx, int wy, svga_t *svga)
 
     if ((svga->crtc[0x17] & 0x80) && ((xs_temp != svga->monitor->mon_xsize) || (ys_temp != svga->monitor->mon_ysize) || video_force_resize_get_monitor(svga->monitor_index))) {
         /* Screen res has changed.. fix up, and let them know. */
+        resized                  = 1;
         svga->monitor->mon_xsize = xs_temp;
         svga->monitor->mon_ysize = ys_temp;
 
@@ -2212,12 +2757,48 @@ svga_doblit(int wx, int wy, svga_t *svga)
         }
     }
 
+    /* Report only the rows that were drawn, so the blitter can skip frames
+       where nothing changed. A resize or a new border colour touches the
+       whole buffer, and so does a frame from a renderer that does not track
+       its rows: 8514/A, XGA or a passthrough card overriding the SVGA. */
+    border = svga->dpms ? 0 : svga->overscan_color;
+    if (resized || (border != svga->dirty_overscan_color) || svga_foreign_render(svga)) {
+        svga->dirty_y1             = 0;
+        svga->dirty_y2             = svga->monitor->mon_ysize + y_add + y_start;
+        svga->dirty_overscan_color = border;
+    }
+    video_blit_set_dirty_monitor(svga->dirty_y1, svga->dirty_y2, svga->monitor_index);
+    svga->dirty_y1 = INT_MAX;
+    svga->dirty_y2 = 0;
+
     video_blit_memtoscreen_monitor(x_start, y_start, svga->monitor->mon_xsize + x_add, svga->monitor->mon_ysize + y_add, svga->monitor_index);
 
     if (svga->vertical_linedbl)
         svga->vertical_linedbl >>= 1;
 }
 
+/* Once a fast linear write has marked its page in changedvram, let the CPU
+   store to that page directly until the next frame or register change.
+   Only called from the svga_write*_lfb() handlers, so banked apertures that
+   reuse the linear handlers keep their decode and XGA snooping. */
+static __inline void
+svga_write_direct(svga_t *svga, uint32_t addr)
+{
+    if (!svga->fast || !svga->direct_lfb || !cpu_use_exec || svga->translate_address)
+        return;
+
+    if (xga_active && (svga->xga != NULL))
+        return;
+
+    if ((svga->writemode != 0) || (svga->gdcreg[3] & 7) || (svga->writemask != 0xf) || !(svga->gdcreg[6] & 1))
+        return;
+
+    if ((svga->decode_mask < 0xfff) || ((addr | 0xfff) >= svga->vram_max))
+        return;
+
+    addwritelookup_direct(mem_logical_addr, &svga->vram[(addr & svga->vram_mask) & ~0xfff]);
+}
+
 void
 svga_writeb_linear(uint32_t addr, uint8_t val, void *priv)
 {
@@ -2363,6 +2944,34 @@ svga_writel_linear(uint32_t addr, uint32_t val, void *priv)
     svga_writel_common(addr, val, 1, priv);
 }
 
+/* Write handlers for the linear frame buffer mapping of direct_lfb cards. */
+void
+svga_writeb_lfb(uint32_t addr, uint8_t val, void *priv)
+{
+    svga_t *svga = (svga_t *) priv;
+
+    svga_writeb_linear(addr, val, priv);
+    svga_write_direct(svga, addr & svga->decode_mask);
+}
+
+void
+svga_writew_lfb(uint32_t addr, uint16_t val, void *priv)
+{
+    svga_t *svga = (svga_t *) priv;
+
+    svga_writew_linear(addr, val, priv);
+    svga_write_direct(svga, addr & svga->decode_mask);
+}
+
+void
+svga_writel_lfb(uint32_t addr, uint32_t val, void *priv)
+{
+    svga_t *svga = (svga_t *) priv;
+
+    svga_writel_linear(addr, val, priv);
+    svga_write_direct(svga, addr & svga->decode_mask);
+}
+
 uint8_t
 svga_readb_linear(uint32_t addr, void *priv)
 {
@@ -2483,3 +3092,173 @@ svga_readl_linear(uint32_t addr, void *priv)
 {
     return svga_readl_common(addr, 1, priv);
 }
+
+/*
+ * Bulk counterparts of the fast paths above, for string instructions and bus
+ * master transfers. They only take over where the per-access handlers would
+ * plain copy to or from VRAM and decline (return 0) otherwise.
+ */
+static __inline uint32_t
+svga_read_block_common(uint32_t addr, void *buf, int width, uint32_t count, uint8_t linear, void *priv)
+{
+    svga_t  *svga = (svga_t *) priv;
+    uint32_t len  = count * width;
+
+    /* Byte reads also load the latches. */
+    if (!svga->fast || svga->translate_address || (width == 1) || !count)
+        return 0;
+
+    if (!linear) {
+        if (xga_active && (svga->xga != NULL))
+            return 0;
+        addr = svga_decode_addr(svga, addr, 0);
+        if (addr == 0xffffffff)
+            return 0;
+    }
+
+    addr &= svga->decode_mask;
+    if (((addr + len - 1) > svga->decode_mask) || ((addr + len) > svga->vram_max))
+        return 0;
+    addr &= svga->vram_mask;
+
+    cycles -= count * ((width == 4) ? svga->monitor->mon_video_timing_read_l : svga->monitor->mon_video_timing_read_w);
+
+    memcpy(buf, &svga->vram[addr], len);
+
+    return count;
+}
+
+static __inline uint32_t
+svga_write_block_common(uint32_t addr, const void *buf, int width, uint32_t count, uint8_t linear, void *priv)
+{
+    svga_t  *svga = (svga_t *) priv;
+    uint32_t len  = count * width;
+
+    if (!svga->fast || svga->translate_address || !count)
+        return 0;
+
+    /* Byte writes still apply the write mode and rotate count. */
+    if ((width == 1) && ((svga->writemode != 0) || (svga->gdcreg[3] & 7)))
+        return 0;
+
+    if (!linear) {
+        if (xga_active && (svga->xga != NULL))
+            return 0;
+        addr = svga_decode_addr(svga, addr, 1);
+        if (addr == 0xffffffff)
+            return 0;
+    }
+
+    addr &= svga->decode_mask;
+    if (((addr + len - 1) > svga->decode_mask) || ((addr + len) > svga->vram_max))
+        return 0;
+    addr &= svga->vram_mask;
+
+    switch (width) {
+        case 1:
+            cycles -= count * svga->monitor->mon_video_timing_write_b;
+            if (!(svga->gdcreg[6] & 1))
+                svga->fullchange = 2;
+            break;
+        case 2:
+            cycles -= count * svga->monitor->mon_video_timing_write_w;
+            break;
+        default:
+            cycles -= count * svga->monitor->mon_video_timing_write_l;
+            break;
+    }
+
+    memcpy(&svga->vram[addr], buf, len);
+    for (uint32_t page = (addr >> 12); page <= ((addr + len - 1) >> 12); page++)
+        svga->changedvram[page] = svga->monitor->mon_changeframecount;
+
+    return count;
+}
+
+uint32_t
+svga_read_block(uint32_t addr, void *buf, int width, uint32_t count, void *priv)
+{
+    return svga_read_block_common(addr, buf, width, count, 0, priv);
+}
+
+uint32_t
+svga_read_block_linear(uint32_t addr, void *buf, int width, uint32_t count, void *priv)
+{
+    return svga_read_block_common(addr, buf, width, count, 1, priv);
+}
+
+uint32_t
+svga_write_block(uint32_t addr, const void *buf, int width, uint32_t count, void *priv)
+{
+    return svga_write_block_common(addr, buf, width, count, 0, priv);
+}
+
+uint32_t
+svga_write_block_linear(uint32_t addr, const void *buf, int width, uint32_t count, void *priv)
+{
+    return svga_write_block_common(addr, buf, width, count, 1, priv);
+}
+
+/*
+ * Row primitives for the bulk paths of the 2D blitters. Addresses are
+ * already masked byte offsets into VRAM and the caller makes sure a span
+ * does not run past its end.
+ */
+void
+svga_blit_changed(svga_t *svga, uint32_t addr, uint32_t len)
+{
+    if (!len)
+        return;
+
+    for (uint32_t page = (addr >> 12); page <= ((addr + len - 1) >> 12); page++)
+        svga->changedvram[page] = svga->monitor->mon_changeframecount;
+}
+
+/* An overlapping copy in the "wrong" direction smears the start of the
+   source over the rest of the span, just like the per-pixel loops do. */
+void
+svga_blit_copy(svga_t *svga, uint32_t dst, uint32_t src, uint32_t len, int backwards)
+{
+    uint8_t       *d = &svga->vram[dst];
+    const uint8_t *s = &svga->vram[src];
+
+    if (!backwards && (src < dst) && (dst < (src + len))) {
+        for (uint32_t x = 0; x < len; x++)
+            d[x] = s[x];
+    } else if (backwards && (dst < src) && (src < (dst + len))) {
+        for (uint32_t x = len; x-- > 0;)
+            d[x] = s[x];
+    } else
+        memmove(d, s, len);
+
+    svga_blit_changed(svga, dst, len);
+}
+
+void
+svga_blit_fill(svga_t *svga, uint32_t dst, uint32_t col, int bytes_pp, uint32_t count)
+{
+    uint8_t *d = &svga->vram[dst];
+
+    switch (bytes_pp) {
+        case 1:
+            memset(d, col, count);
+            break;
+        case 2:
+            for (uint32_t x = 0; x < count; x++)
+                ((uint16_t *) d)[x] = col;
+            break;
+        case 3:
+            for (uint32_t x = 0; x < count; x++, d += 3) {
+                d[0] = col;
+                d[1] = col >> 8;
+                d[2] = col >> 16;
+            }
+            break;
+        default:
+            for (uint32_t x = 0; x < count; x++)
+                ((uint32_t *) d)[x] = col;
+            break;
+    }
+
+    svga_blit_changed(svga, dst, count * bytes_pp);
+}
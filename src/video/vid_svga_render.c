@@ -42,6 +42,23 @@ svga_lookup_lut_ram(svga_t* svga, uint32_t val)
 
 #define lookup_lut(val) svga_lookup_lut_ram(svga, val)
 
+/*
+   Number of pixels the unrolled loops below draw for this line when they
+   step by `step`, or 0 if the source would wrap around the end of display
+   memory, in which case the line has to take the per-pixel path.
+ */
+static __inline int
+svga_render_span(svga_t *svga, int step, int bytes_per_pixel)
+{
+    int      count = (((svga->hdisp + svga->scrollcache) / step) + 1) * step;
+    uint32_t addr  = svga->memaddr & svga->vram_display_mask;
+
+    if ((addr + (count * bytes_per_pixel) + 4) > (svga->vram_display_mask + 1))
+        return 0;
+
+    return count;
+}
+
 void
 svga_render_null(svga_t *svga)
 {
@@ -132,6 +149,19 @@ svga_render_overscan_right(svga_t *svga)
     }
 }
 
+/* The glyph cache, with the 16 text colours as they resolve now. */
+static glyph_cache_t *
+svga_glyph_cache(svga_t *svga)
+{
+    uint32_t pal[16];
+
+    for (int c = 0; c < 16; c++)
+        pal[c] = svga->pallook[svga->egapal[c] & svga->dac_mask];
+    glyph_cache_set_palette(svga->glyph_cache, pal);
+
+    return svga->glyph_cache;
+}
+
 void
 svga_render_text_40(svga_t *svga)
 {
@@ -146,6 +176,8 @@ svga_render_text_40(svga_t *svga)
     int       fg;
     int       bg;
     uint32_t  addr = 0;
+    const uint32_t *row;
+    glyph_cache_t  *gc;
 
     if (svga->render_override) {
         svga->render_override(svga->priv_parent);
@@ -162,6 +194,7 @@ svga_render_text_40(svga_t *svga)
     if (svga->fullchange) {
         p    = &svga->monitor->target_buffer->line[(svga->displine + svga->y_add) & 2047][(svga->x_add) & 2047];
         xinc = (svga->seqregs[1] & 1) ? 16 : 18;
+        gc   = svga_glyph_cache(svga);
 
         for (int x = 0; x < (svga->hdisp + svga->scrollcache); x += xinc) {
             if (!svga->force_old_addr)
@@ -183,30 +216,28 @@ svga_render_text_40(svga_t *svga)
                 charaddr = svga->charseta + (chr * 128);
 
             if (drawcursor) {
-                bg = svga->pallook[svga->egapal[attr & 15] & svga->dac_mask];
-                fg = svga->pallook[svga->egapal[attr >> 4] & svga->dac_mask];
+                bg = attr & 15;
+                fg = attr >> 4;
             } else {
-                fg = svga->pallook[svga->egapal[attr & 15] & svga->dac_mask];
-                bg = svga->pallook[svga->egapal[attr >> 4] & svga->dac_mask];
+                fg = attr & 15;
+                bg = attr >> 4;
 
                 if (attr & 0x80 && svga->attrregs[0x10] & 8) {
-                    bg = svga->pallook[svga->egapal[(attr >> 4) & 7] & svga->dac_mask];
+                    bg = (attr >> 4) & 7;
                     if (svga->blink & 16)
                         fg = bg;
                 }
             }
 
             dat = svga->vram[charaddr + (svga->scanline << 2)];
-            if (svga->seqregs[1] & 1) {
-                for (xx = 0; xx < 16; xx += 2)
-                    p[xx] = p[xx + 1] = (dat & (0x80 >> (xx >> 1))) ? fg : bg;
-            } else {
-                for (xx = 0; xx < 16; xx += 2)
-                    p[xx] = p[xx + 1] = (dat & (0x80 >> (xx >> 1))) ? fg : bg;
+            row = glyph_cache_row(gc, fg, bg, dat);
+            for (xx = 0; xx < 16; xx += 2)
+                p[xx] = p[xx + 1] = row[xx >> 1];
+            if (!(svga->seqregs[1] & 1)) {
                 if ((chr & ~0x1f) != 0xc0 || !(svga->attrregs[0x10] & 4))
-                    p[16] = p[17] = bg;
+                    p[16] = p[17] = gc->pal[bg];
                 else
-                    p[16] = p[17] = (dat & 1) ? fg : bg;
+                    p[16] = p[17] = row[7];
             }
             svga->memaddr += 4;
             p += xinc;
@@ -247,6 +278,7 @@ svga_render_text_80(svga_t *svga)
         xinc = (svga->seqregs[1] & 1) ? 8 : 9;
 
         static uint32_t col = 0x00000000;
+        glyph_cache_t  *gc  = (svga->attrregs[0x10] & 0x40) ? NULL : svga_glyph_cache(svga);
 
         for (int x = 0; x < (svga->hdisp + svga->scrollcache); x += xinc) {
             if (!svga->force_old_addr)
@@ -315,21 +347,14 @@ svga_render_text_80(svga_t *svga)
                     }
                 }
             } else {
-                if (svga->seqregs[1] & 1) {
-                    for (xx = 0; xx < 8; xx++) {
-                        col = (col << 4) | ((dat & (0x80 >> xx)) ? fg : bg);
-                        p[xx] = svga->pallook[svga->egapal[col & 0x0f] & svga->dac_mask];
-                    }
-                } else {
-                    for (xx = 0; xx < 8; xx++) {
-                        col = (col << 4) | ((dat & (0x80 >> xx)) ? fg : bg);
-                        p[xx] = svga->pallook[svga->egapal[col & 0x0f] & svga->dac_mask];
-                    }
+                const uint32_t *row = glyph_cache_row(gc, fg, bg, dat);
+
+                memcpy(p, row, 8 * sizeof(uint32_t));
+                if (!(svga->seqregs[1] & 1)) {
                     if ((chr & ~0x1F) != 0xC0 || !(svga->attrregs[0x10] & 4))
-                        col = (col << 4) | bg;
+                        p[8] = gc->pal[bg];
                     else
-                        col = (col << 4) | ((dat & 1) ? fg : bg);
-                    p[8] = svga->pallook[svga->egapal[col & 0x0f] & svga->dac_mask];
+                        p[8] = row[7];
                 }
             }
 
@@ -722,6 +747,28 @@ svga_render_2bpp_headland_highres(svga_t *svga)
     }
 }
 
+/*
+   Whether 8bpp highres would fetch consecutive VRAM bytes and look each one
+   up in the palette, with every plane enabled and no blink.
+ */
+int
+svga_render_8bpp_is_linear(svga_t *svga)
+{
+    if (svga->force_old_addr || svga->remap_required || svga->packed_4bpp ||
+        svga->half_pixel || svga->ati_4color || (svga->plane_mask != 0x0f))
+        return 0;
+
+    if (!svga->disable_blink && (svga->attrregs[0x10] & 0x08))
+        return 0;
+
+    /* Packed chain-4 ignores the load and increment controls. */
+    if (svga->packed_chain4)
+        return 1;
+
+    return !(svga->seqregs[0x01] & 0x14) && !(svga->crtc[0x17] & 0x08) &&
+           !(svga->crtc[0x14] & 0x60) && (svga->crtc[0x17] & 0x40);
+}
+
 static void
 svga_render_indexed_gfx(svga_t *svga, bool highres, bool combine8bits)
 {
@@ -812,6 +859,23 @@ svga_render_indexed_gfx(svga_t *svga, bool highres, bool combine8bits)
     uint32_t edat         = 0;
     static uint32_t col          = 0;
     static uint32_t col2         = 0;
+
+    /*
+       Plain linear 8bpp with every plane enabled and no blink is a straight
+       palette lookup of consecutive bytes.
+     */
+    if (combine8bits && highres && svga_render_8bpp_is_linear(svga)) {
+        const int count = svga_render_span(svga, charwidth, 1);
+
+        if (count) {
+            svga_line_8to32(p, &svga->vram[svga->memaddr & svga->vram_display_mask], svga->map8, svga->dac_mask, count);
+            col = p[count - 1];
+            svga->memaddr += count;
+            svga->memaddr &= svga->vram_display_mask;
+            goto line_done;
+        }
+    }
+
     for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += charwidth) {
         if (load_counter == 0) {
             /* Find our address */
@@ -989,6 +1053,7 @@ svga_render_indexed_gfx(svga_t *svga, bool highres, bool combine8bits)
             p += charwidth;
     }
 
+line_done:
     if (svga->render_line_offset < 0) {
         uint32_t *orig_line = &svga->monitor->target_buffer->line[svga->displine + svga->y_add][svga->x_add];
         memmove(orig_line, orig_line + (charwidth * -svga->render_line_offset), (svga->hdisp) * 4);
@@ -1616,24 +1681,31 @@ svga_render_15bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1)) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 4) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+                const int count = (svga->conv_16to32 == svga_conv_16to32) ? svga_render_span(svga, 8, 2) : 0;
 
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 8) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 12) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+                if (count) {
+                    svga_line_15to32(p, (const uint16_t *) &svga->vram[svga->memaddr & svga->vram_display_mask], count);
+                    svga->memaddr += count << 1;
+                } else {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1)) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 4) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 8) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 12) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+                    }
+                    svga->memaddr += x << 1;
                 }
-                svga->memaddr += x << 1;
             } else {
                 for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 2) {
                     addr = svga->remap_func(svga, svga->memaddr);
@@ -1848,24 +1920,31 @@ svga_render_16bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1)) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 4) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 8) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+                const int count = (svga->conv_16to32 == svga_conv_16to32) ? svga_render_span(svga, 8, 2) : 0;
 
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 12) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+                if (count) {
+                    svga_line_16to32(p, (const uint16_t *) &svga->vram[svga->memaddr & svga->vram_display_mask], count);
+                    svga->memaddr += count << 1;
+                } else {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1)) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 4) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 8) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 1) + 12) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+                    }
+                    svga->memaddr += x << 1;
                 }
-                svga->memaddr += x << 1;
             } else {
                 for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 2) {
                     addr = svga->remap_func(svga, svga->memaddr);
@@ -2009,17 +2088,24 @@ svga_render_24bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 4) {
-                    dat0 = *(uint32_t *) (&svga->vram[svga->memaddr & svga->vram_display_mask]);
-                    dat1 = *(uint32_t *) (&svga->vram[(svga->memaddr + 4) & svga->vram_display_mask]);
-                    dat2 = *(uint32_t *) (&svga->vram[(svga->memaddr + 8) & svga->vram_display_mask]);
+                const int count = !svga->lut_map ? svga_render_span(svga, 4, 3) : 0;
 
-                    *p++ = lookup_lut(dat0 & 0xffffff);
-                    *p++ = lookup_lut((dat0 >> 24) | ((dat1 & 0xffff) << 8));
-                    *p++ = lookup_lut((dat1 >> 16) | ((dat2 & 0xff) << 16));
-                    *p++ = lookup_lut(dat2 >> 8);
+                if (count) {
+                    svga_line_24to32(p, &svga->vram[svga->memaddr & svga->vram_display_mask], count);
+                    svga->memaddr += count * 3;
+                } else {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 4) {
+                        dat0 = *(uint32_t *) (&svga->vram[svga->memaddr & svga->vram_display_mask]);
+                        dat1 = *(uint32_t *) (&svga->vram[(svga->memaddr + 4) & svga->vram_display_mask]);
+                        dat2 = *(uint32_t *) (&svga->vram[(svga->memaddr + 8) & svga->vram_display_mask]);
 
-                    svga->memaddr += 12;
+                        *p++ = lookup_lut(dat0 & 0xffffff);
+                        *p++ = lookup_lut((dat0 >> 24) | ((dat1 & 0xffff) << 8));
+                        *p++ = lookup_lut((dat1 >> 16) | ((dat2 & 0xff) << 16));
+                        *p++ = lookup_lut(dat2 >> 8);
+
+                        svga->memaddr += 12;
+                    }
                 }
             } else {
                 for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 4) {
@@ -2137,11 +2223,18 @@ svga_render_32bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
-                    dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 2)) & svga->vram_display_mask]);
-                    *p++ = lookup_lut(dat & 0xffffff);
+                const int count = !svga->lut_map ? svga_render_span(svga, 1, 4) : 0;
+
+                if (count) {
+                    svga_line_32to32(p, (const uint32_t *) &svga->vram[svga->memaddr & svga->vram_display_mask], count);
+                    svga->memaddr += count * 4;
+                } else {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
+                        dat  = *(uint32_t *) (&svga->vram[(svga->memaddr + (x << 2)) & svga->vram_display_mask]);
+                        *p++ = lookup_lut(dat & 0xffffff);
+                    }
+                    svga->memaddr += (x * 4);
                 }
-                svga->memaddr += (x * 4);
             } else {
                 for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
                     addr = svga->remap_func(svga, svga->memaddr);
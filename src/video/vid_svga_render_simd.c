@@ -0,0 +1,593 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Vectorised scanline kernels for the SVGA renderers.
+ *
+ *          Each kernel converts one contiguous run of VRAM into 32-bit
+ *          pixels. The renderers only call them for linear, unwrapped
+ *          spans with no RAMDAC LUT or custom 16-bit conversion active,
+ *          so the output must match the scalar paths bit for bit.
+ *
+ *          The YUV 4:2:2 kernel is shared by the video overlays of the
+ *          Banshee/Voodoo 3, S3 streams processor and Mach64 scaler,
+ *          and must likewise match the conversion they used to do one
+ *          pixel at a time.
+ *
+ *
+ *
+ * Authors: agent, <agent@local>
+ *
+ *          Copyright 2025 agent.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include <86box/device.h>
+#include <86box/mem.h>
+#include <86box/timer.h>
+#include <86box/video.h>
+#include <86box/vid_svga.h>
+#include <86box/vid_svga_render.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define SVGA_SIMD_X86
+#    include <immintrin.h>
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#        define SVGA_TARGET_SSE2
+#        define SVGA_TARGET_AVX2
+#    else
+#        define SVGA_TARGET_SSE2 __attribute__((target("sse2")))
+#        define SVGA_TARGET_AVX2 __attribute__((target("avx2")))
+#    endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || (defined(__ARM_NEON) && defined(__GNUC__))
+#    define SVGA_SIMD_NEON
+#    include <arm_neon.h>
+#endif
+
+#ifdef ENABLE_SVGA_RENDER_SIMD_LOG
+int svga_render_simd_do_log = ENABLE_SVGA_RENDER_SIMD_LOG;
+
+static void
+svga_render_simd_log(const char *fmt, ...)
+{
+    va_list ap;
+
+    if (svga_render_simd_do_log) {
+        va_start(ap, fmt);
+        pclog_ex(fmt, ap);
+        va_end(ap);
+    }
+}
+#else
+#    define svga_render_simd_log(fmt, ...)
+#endif
+
+/*The 15/16 bpp tables round 5 and 6 bit components as trunc(c * 255 / 31)
+  and trunc(c * 255 / 63). The same values come out of (c * 1053) >> 7 and
+  (c * 4145) >> 10, which the vector paths compute as a 16-bit high multiply
+  of the component shifted up by 9 and 6 bits respectively.*/
+#define RGB5_MUL 1053
+#define RGB6_MUL 4145
+
+static void
+svga_line_8to32_c(uint32_t *dst, const uint8_t *src, const uint32_t *pal, uint8_t mask, int count)
+{
+    for (int x = 0; x < count; x++)
+        dst[x] = pal[src[x] & mask];
+}
+
+static void
+svga_line_15to32_c(uint32_t *dst, const uint16_t *src, int count)
+{
+    for (int x = 0; x < count; x++)
+        dst[x] = video_15to32[src[x]];
+}
+
+static void
+svga_line_16to32_c(uint32_t *dst, const uint16_t *src, int count)
+{
+    for (int x = 0; x < count; x++)
+        dst[x] = video_16to32[src[x]];
+}
+
+static void
+svga_line_24to32_c(uint32_t *dst, const uint8_t *src, int count)
+{
+    for (int x = 0; x < count; x++) {
+        dst[x] = src[0] | (src[1] << 8) | (src[2] << 16);
+        src += 3;
+    }
+}
+
+static void
+svga_line_32to32_c(uint32_t *dst, const uint32_t *src, int count)
+{
+    for (int x = 0; x < count; x++)
+        dst[x] = src[x] & 0xffffff;
+}
+
+static __inline int
+svga_clamp8(int c)
+{
+    if (c & ~0xff)
+        c = (c < 0) ? 0 : 0xff;
+
+    return c;
+}
+
+/*dR = 359 Cr / 256, dG = (88 Cb + 183 Cr) / 256 and dB = 453 Cb / 256, each
+  rounded down, added to full range luma. count is in pixels and even.*/
+static void
+svga_line_yuv422to32_c(uint32_t *dst, const uint8_t *src, int fmt, int count)
+{
+    const int yo = (fmt & SVGA_YUV_Y_ODD) ? 1 : 0;
+    const int ro = (fmt & SVGA_YUV_V_FIRST) ? (yo ^ 1) : ((yo ^ 1) + 2);
+    const int bo = ro ^ 2;
+
+    for (int x = 0; x < count; x += 2) {
+        const int8_t cr = src[ro] - 0x80;
+        const int8_t cb = src[bo] - 0x80;
+        const int    dR = (359 * cr) >> 8;
+        const int    dG = (88 * cb + 183 * cr) >> 8;
+        const int    dB = (453 * cb) >> 8;
+
+        for (int c = 0; c < 2; c++) {
+            const int y = src[yo + (c << 1)];
+            const int r = svga_clamp8(y + dR);
+            const int g = svga_clamp8(y - dG);
+            const int b = svga_clamp8(y + dB);
+
+            if (fmt & SVGA_YUV_BGR)
+                dst[x + c] = r | (g << 8) | (b << 16);
+            else
+                dst[x + c] = (r << 16) | (g << 8) | b;
+        }
+        src += 4;
+    }
+}
+
+#ifdef SVGA_SIMD_X86
+SVGA_TARGET_SSE2 static void
+svga_line_15to32_sse2(uint32_t *dst, const uint16_t *src, int count)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x3e00);
+    const __m128i mul5  = _mm_set1_epi16(RGB5_MUL);
+    const __m128i alpha = _mm_set1_epi16((int16_t) 0xff00);
+    int           x     = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        __m128i px = _mm_loadu_si128((const __m128i *) &src[x]);
+        __m128i r  = _mm_mulhi_epu16(_mm_and_si128(_mm_srli_epi16(px, 1), mask5), mul5);
+        __m128i g  = _mm_mulhi_epu16(_mm_and_si128(_mm_slli_epi16(px, 4), mask5), mul5);
+        __m128i b  = _mm_mulhi_epu16(_mm_and_si128(_mm_slli_epi16(px, 9), mask5), mul5);
+        __m128i gb = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        __m128i ar = _mm_or_si128(r, alpha);
+
+        _mm_storeu_si128((__m128i *) &dst[x], _mm_unpacklo_epi16(gb, ar));
+        _mm_storeu_si128((__m128i *) &dst[x + 4], _mm_unpackhi_epi16(gb, ar));
+    }
+
+    svga_line_15to32_c(&dst[x], &src[x], count - x);
+}
+
+SVGA_TARGET_SSE2 static void
+svga_line_16to32_sse2(uint32_t *dst, const uint16_t *src, int count)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x3e00);
+    const __m128i mask6 = _mm_set1_epi16(0x0fc0);
+    const __m128i mul5  = _mm_set1_epi16(RGB5_MUL);
+    const __m128i mul6  = _mm_set1_epi16(RGB6_MUL);
+    const __m128i alpha = _mm_set1_epi16((int16_t) 0xff00);
+    int           x     = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        __m128i px = _mm_loadu_si128((const __m128i *) &src[x]);
+        __m128i r  = _mm_mulhi_epu16(_mm_and_si128(_mm_srli_epi16(px, 2), mask5), mul5);
+        __m128i g  = _mm_mulhi_epu16(_mm_and_si128(_mm_slli_epi16(px, 1), mask6), mul6);
+        __m128i b  = _mm_mulhi_epu16(_mm_and_si128(_mm_slli_epi16(px, 9), mask5), mul5);
+        __m128i gb = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        __m128i ar = _mm_or_si128(r, alpha);
+
+        _mm_storeu_si128((__m128i *) &dst[x], _mm_unpacklo_epi16(gb, ar));
+        _mm_storeu_si128((__m128i *) &dst[x + 4], _mm_unpackhi_epi16(gb, ar));
+    }
+
+    svga_line_16to32_c(&dst[x], &src[x], count - x);
+}
+
+SVGA_TARGET_SSE2 static void
+svga_line_32to32_sse2(uint32_t *dst, const uint32_t *src, int count)
+{
+    const __m128i mask = _mm_set1_epi32(0x00ffffff);
+    int           x    = 0;
+
+    for (; x + 4 <= count; x += 4)
+        _mm_storeu_si128((__m128i *) &dst[x], _mm_and_si128(_mm_loadu_si128((const __m128i *) &src[x]), mask));
+
+    svga_line_32to32_c(&dst[x], &src[x], count - x);
+}
+
+/*359 and 453 times a chroma value overflow 16 bits, so the chroma is
+  shifted up by 7 and multiplied by twice the factor instead; the high half
+  of the product is then exactly the rounded down quotient. dG sums two
+  products before its shift, so it is done in 32 bits.*/
+SVGA_TARGET_SSE2 static void
+svga_line_yuv422to32_sse2(uint32_t *dst, const uint8_t *src, int fmt, int count)
+{
+    const __m128i lo8   = _mm_set1_epi16(0x00ff);
+    const __m128i bias  = _mm_set1_epi16(0x80);
+    const __m128i mul_r = _mm_set1_epi16(359 * 2);
+    const __m128i mul_b = _mm_set1_epi16(453 * 2);
+    const __m128i mul_g = _mm_set_epi16(183, 88, 183, 88, 183, 88, 183, 88);
+    const __m128i zero  = _mm_setzero_si128();
+    int           x     = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i *) &src[x << 1]);
+        __m128i y;
+        __m128i c;
+        __m128i c1;
+        __m128i c2;
+        __m128i cr;
+        __m128i cb;
+        __m128i r;
+        __m128i g;
+        __m128i b;
+        __m128i dg;
+
+        if (fmt & SVGA_YUV_Y_ODD) {
+            y = _mm_srli_epi16(in, 8);
+            c = _mm_and_si128(in, lo8);
+        } else {
+            y = _mm_and_si128(in, lo8);
+            c = _mm_srli_epi16(in, 8);
+        }
+        c = _mm_sub_epi16(c, bias);
+
+        /*Give every pixel the chroma of its pair.*/
+        c1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+        c2 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+        cr = (fmt & SVGA_YUV_V_FIRST) ? c1 : c2;
+        cb = (fmt & SVGA_YUV_V_FIRST) ? c2 : c1;
+
+        dg = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, cr), mul_g), 8),
+                             _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, cr), mul_g), 8));
+        r  = _mm_packus_epi16(_mm_add_epi16(y, _mm_mulhi_epi16(_mm_slli_epi16(cr, 7), mul_r)), zero);
+        g  = _mm_packus_epi16(_mm_sub_epi16(y, dg), zero);
+        b  = _mm_packus_epi16(_mm_add_epi16(y, _mm_mulhi_epi16(_mm_slli_epi16(cb, 7), mul_b)), zero);
+
+        if (fmt & SVGA_YUV_BGR) {
+            __m128i t = r;
+
+            r = b;
+            b = t;
+        }
+
+        b = _mm_unpacklo_epi8(b, g);
+        r = _mm_unpacklo_epi8(r, zero);
+        _mm_storeu_si128((__m128i *) &dst[x], _mm_unpacklo_epi16(b, r));
+        _mm_storeu_si128((__m128i *) &dst[x + 4], _mm_unpackhi_epi16(b, r));
+    }
+
+    svga_line_yuv422to32_c(&dst[x], &src[x << 1], fmt, count - x);
+}
+
+SVGA_TARGET_AVX2 static void
+svga_line_8to32_avx2(uint32_t *dst, const uint8_t *src, const uint32_t *pal, uint8_t mask, int count)
+{
+    const __m256i vmask = _mm256_set1_epi32(mask);
+    int           x     = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) &src[x]));
+
+        idx = _mm256_and_si256(idx, vmask);
+        _mm256_storeu_si256((__m256i *) &dst[x], _mm256_i32gather_epi32((const int *) pal, idx, 4));
+    }
+
+    svga_line_8to32_c(&dst[x], &src[x], pal, mask, count - x);
+}
+
+SVGA_TARGET_AVX2 static void
+svga_line_15to32_avx2(uint32_t *dst, const uint16_t *src, int count)
+{
+    const __m256i mask5 = _mm256_set1_epi16(0x3e00);
+    const __m256i mul5  = _mm256_set1_epi16(RGB5_MUL);
+    const __m256i alpha = _mm256_set1_epi16((int16_t) 0xff00);
+    int           x     = 0;
+
+    for (; x + 16 <= count; x += 16) {
+        __m256i px = _mm256_loadu_si256((const __m256i *) &src[x]);
+        __m256i r  = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_srli_epi16(px, 1), mask5), mul5);
+        __m256i g  = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_slli_epi16(px, 4), mask5), mul5);
+        __m256i b  = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_slli_epi16(px, 9), mask5), mul5);
+        __m256i gb = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+        __m256i ar = _mm256_or_si256(r, alpha);
+        __m256i lo = _mm256_unpacklo_epi16(gb, ar);
+        __m256i hi = _mm256_unpackhi_epi16(gb, ar);
+
+        /*The unpacks work within each 128-bit lane, so put the halves back in order.*/
+        _mm256_storeu_si256((__m256i *) &dst[x], _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *) &dst[x + 8], _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    svga_line_15to32_c(&dst[x], &src[x], count - x);
+}
+
+SVGA_TARGET_AVX2 static void
+svga_line_16to32_avx2(uint32_t *dst, const uint16_t *src, int count)
+{
+    const __m256i mask5 = _mm256_set1_epi16(0x3e00);
+    const __m256i mask6 = _mm256_set1_epi16(0x0fc0);
+    const __m256i mul5  = _mm256_set1_epi16(RGB5_MUL);
+    const __m256i mul6  = _mm256_set1_epi16(RGB6_MUL);
+    const __m256i alpha = _mm256_set1_epi16((int16_t) 0xff00);
+    int           x     = 0;
+
+    for (; x + 16 <= count; x += 16) {
+        __m256i px = _mm256_loadu_si256((const __m256i *) &src[x]);
+        __m256i r  = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_srli_epi16(px, 2), mask5), mul5);
+        __m256i g  = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_slli_epi16(px, 1), mask6), mul6);
+        __m256i b  = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_slli_epi16(px, 9), mask5), mul5);
+        __m256i gb = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+        __m256i ar = _mm256_or_si256(r, alpha);
+        __m256i lo = _mm256_unpacklo_epi16(gb, ar);
+        __m256i hi = _mm256_unpackhi_epi16(gb, ar);
+
+        _mm256_storeu_si256((__m256i *) &dst[x], _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *) &dst[x + 8], _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    svga_line_16to32_c(&dst[x], &src[x], count - x);
+}
+
+SVGA_TARGET_AVX2 static void
+svga_line_24to32_avx2(uint32_t *dst, const uint8_t *src, int count)
+{
+    const __m256i shuf = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                          0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    int           x    = 0;
+
+    /*Each step loads 28 bytes for 24 bytes of pixels, so stop early enough
+      that the over-read stays inside the span.*/
+    for (; x + 10 <= count; x += 8) {
+        __m128i lo = _mm_loadu_si128((const __m128i *) &src[x * 3]);
+        __m128i hi = _mm_loadu_si128((const __m128i *) &src[(x * 3) + 12]);
+        __m256i px = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+        _mm256_storeu_si256((__m256i *) &dst[x], _mm256_shuffle_epi8(px, shuf));
+    }
+
+    svga_line_24to32_c(&dst[x], &src[x * 3], count - x);
+}
+
+SVGA_TARGET_AVX2 static void
+svga_line_32to32_avx2(uint32_t *dst, const uint32_t *src, int count)
+{
+    const __m256i mask = _mm256_set1_epi32(0x00ffffff);
+    int           x    = 0;
+
+    for (; x + 8 <= count; x += 8)
+        _mm256_storeu_si256((__m256i *) &dst[x], _mm256_and_si256(_mm256_loadu_si256((const __m256i *) &src[x]), mask));
+
+    svga_line_32to32_c(&dst[x], &src[x], count - x);
+}
+
+static int
+svga_cpu_has_sse2(void)
+{
+#    if defined(__x86_64__) || defined(_M_X64)
+    return 1;
+#    elif defined(_MSC_VER)
+    int regs[4];
+
+    __cpuid(regs, 1);
+    return !!(regs[3] & (1 << 26));
+#    else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#    endif
+}
+
+static int
+svga_cpu_has_avx2(void)
+{
+#    ifdef _MSC_VER
+    int regs[4];
+
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return 0;
+    __cpuid(regs, 1);
+    /*AVX and OSXSAVE, then check the OS saves the YMM state.*/
+    if ((regs[2] & 0x18000000) != 0x18000000)
+        return 0;
+    if ((_xgetbv(0) & 6) != 6)
+        return 0;
+    __cpuidex(regs, 7, 0);
+    return !!(regs[1] & (1 << 5));
+#    else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#    endif
+}
+#endif
+
+#ifdef SVGA_SIMD_NEON
+/*NEON has no 16-bit high multiply, so split the multipliers: 1053 = 1024 + 29
+  and 4145 = 4096 + 49, where the first term is an exact shift.*/
+static __inline uint8x8_t
+svga_expand5_neon(uint16x8_t c)
+{
+    return vmovn_u16(vaddq_u16(vshlq_n_u16(c, 3), vshrq_n_u16(vmulq_n_u16(c, RGB5_MUL - 1024), 7)));
+}
+
+static __inline uint8x8_t
+svga_expand6_neon(uint16x8_t c)
+{
+    return vmovn_u16(vaddq_u16(vshlq_n_u16(c, 2), vshrq_n_u16(vmulq_n_u16(c, RGB6_MUL - 4096), 10)));
+}
+
+static void
+svga_line_15to32_neon(uint32_t *dst, const uint16_t *src, int count)
+{
+    const uint16x8_t mask5 = vdupq_n_u16(0x1f);
+    int              x     = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        uint16x8_t px = vld1q_u16(&src[x]);
+        uint8x8x4_t out;
+
+        out.val[0] = svga_expand5_neon(vandq_u16(px, mask5));
+        out.val[1] = svga_expand5_neon(vandq_u16(vshrq_n_u16(px, 5), mask5));
+        out.val[2] = svga_expand5_neon(vandq_u16(vshrq_n_u16(px, 10), mask5));
+        out.val[3] = vdup_n_u8(0xff);
+        vst4_u8((uint8_t *) &dst[x], out);
+    }
+
+    svga_line_15to32_c(&dst[x], &src[x], count - x);
+}
+
+static void
+svga_line_16to32_neon(uint32_t *dst, const uint16_t *src, int count)
+{
+    const uint16x8_t mask5 = vdupq_n_u16(0x1f);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3f);
+    int              x     = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        uint16x8_t px = vld1q_u16(&src[x]);
+        uint8x8x4_t out;
+
+        out.val[0] = svga_expand5_neon(vandq_u16(px, mask5));
+        out.val[1] = svga_expand6_neon(vandq_u16(vshrq_n_u16(px, 5), mask6));
+        out.val[2] = svga_expand5_neon(vshrq_n_u16(px, 11));
+        out.val[3] = vdup_n_u8(0xff);
+        vst4_u8((uint8_t *) &dst[x], out);
+    }
+
+    svga_line_16to32_c(&dst[x], &src[x], count - x);
+}
+
+static void
+svga_line_24to32_neon(uint32_t *dst, const uint8_t *src, int count)
+{
+    int x = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        uint8x8x3_t in = vld3_u8(&src[x * 3]);
+        uint8x8x4_t out;
+
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = in.val[2];
+        out.val[3] = vdup_n_u8(0);
+        vst4_u8((uint8_t *) &dst[x], out);
+    }
+
+    svga_line_24to32_c(&dst[x], &src[x * 3], count - x);
+}
+
+static void
+svga_line_32to32_neon(uint32_t *dst, const uint32_t *src, int count)
+{
+    const uint32x4_t mask = vdupq_n_u32(0x00ffffff);
+    int              x    = 0;
+
+    for (; x + 4 <= count; x += 4)
+        vst1q_u32(&dst[x], vandq_u32(vld1q_u32(&src[x]), mask));
+
+    svga_line_32to32_c(&dst[x], &src[x], count - x);
+}
+
+static __inline int16x8_t
+svga_yuv_mul_neon(int16x8_t c, int16_t m)
+{
+    return vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(c), m), 8),
+                        vshrn_n_s32(vmull_n_s16(vget_high_s16(c), m), 8));
+}
+
+static void
+svga_line_yuv422to32_neon(uint32_t *dst, const uint8_t *src, int fmt, int count)
+{
+    const int       yo   = (fmt & SVGA_YUV_Y_ODD) ? 1 : 0;
+    const int       ro   = (fmt & SVGA_YUV_V_FIRST) ? (yo ^ 1) : ((yo ^ 1) + 2);
+    const int16x8_t bias = vdupq_n_s16(0x80);
+    int             x    = 0;
+
+    for (; x + 16 <= count; x += 16) {
+        uint8x8x4_t in = vld4_u8(&src[x << 1]);
+        int16x8_t   y0 = vreinterpretq_s16_u16(vmovl_u8(in.val[yo]));
+        int16x8_t   y1 = vreinterpretq_s16_u16(vmovl_u8(in.val[yo + 2]));
+        int16x8_t   cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(in.val[ro])), bias);
+        int16x8_t   cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(in.val[ro ^ 2])), bias);
+        int16x8_t   dr = svga_yuv_mul_neon(cr, 359);
+        int16x8_t   db = svga_yuv_mul_neon(cb, 453);
+        int16x8_t   dg = vcombine_s16(vshrn_n_s32(vmlal_n_s16(vmull_n_s16(vget_low_s16(cb), 88), vget_low_s16(cr), 183), 8),
+                                      vshrn_n_s32(vmlal_n_s16(vmull_n_s16(vget_high_s16(cb), 88), vget_high_s16(cr), 183), 8));
+        uint8x8x2_t r  = vzip_u8(vqmovun_s16(vaddq_s16(y0, dr)), vqmovun_s16(vaddq_s16(y1, dr)));
+        uint8x8x2_t g  = vzip_u8(vqmovun_s16(vsubq_s16(y0, dg)), vqmovun_s16(vsubq_s16(y1, dg)));
+        uint8x8x2_t b  = vzip_u8(vqmovun_s16(vaddq_s16(y0, db)), vqmovun_s16(vaddq_s16(y1, db)));
+
+        for (int h = 0; h < 2; h++) {
+            uint8x8x4_t out;
+
+            out.val[0] = (fmt & SVGA_YUV_BGR) ? r.val[h] : b.val[h];
+            out.val[1] = g.val[h];
+            out.val[2] = (fmt & SVGA_YUV_BGR) ? b.val[h] : r.val[h];
+            out.val[3] = vdup_n_u8(0);
+            vst4_u8((uint8_t *) &dst[x + (h << 3)], out);
+        }
+    }
+
+    svga_line_yuv422to32_c(&dst[x], &src[x << 1], fmt, count - x);
+}
+#endif
+
+void (*svga_line_8to32)(uint32_t *dst, const uint8_t *src, const uint32_t *pal, uint8_t mask, int count) = svga_line_8to32_c;
+void (*svga_line_15to32)(uint32_t *dst, const uint16_t *src, int count)                                  = svga_line_15to32_c;
+void (*svga_line_16to32)(uint32_t *dst, const uint16_t *src, int count)                                  = svga_line_16to32_c;
+void (*svga_line_24to32)(uint32_t *dst, const uint8_t *src, int count)                                   = svga_line_24to32_c;
+void (*svga_line_32to32)(uint32_t *dst, const uint32_t *src, int count)                                  = svga_line_32to32_c;
+void (*svga_line_yuv422to32)(uint32_t *dst, const uint8_t *src, int fmt, int count)                      = svga_line_yuv422to32_c;
+
+void
+svga_render_simd_init(void)
+{
+#if defined(SVGA_SIMD_X86)
+    if (svga_cpu_has_avx2()) {
+        svga_line_8to32      = svga_line_8to32_avx2;
+        svga_line_15to32     = svga_line_15to32_avx2;
+        svga_line_16to32     = svga_line_16to32_avx2;
+        svga_line_24to32     = svga_line_24to32_avx2;
+        svga_line_32to32     = svga_line_32to32_avx2;
+        svga_line_yuv422to32 = svga_line_yuv422to32_sse2;
+        svga_render_simd_log("SVGA render: using AVX2 scanline kernels\n");
+    } else if (svga_cpu_has_sse2()) {
+        /*No byte shuffles or gathers in SSE2, so palette and 24 bpp
+          lookups stay scalar.*/
+        svga_line_15to32     = svga_line_15to32_sse2;
+        svga_line_16to32     = svga_line_16to32_sse2;
+        svga_line_32to32     = svga_line_32to32_sse2;
+        svga_line_yuv422to32 = svga_line_yuv422to32_sse2;
+        svga_render_simd_log("SVGA render: using SSE2 scanline kernels\n");
+    }
+#elif defined(SVGA_SIMD_NEON)
+    svga_line_15to32     = svga_line_15to32_neon;
+    svga_line_16to32     = svga_line_16to32_neon;
+    svga_line_24to32     = svga_line_24to32_neon;
+    svga_line_32to32     = svga_line_32to32_neon;
+    svga_line_yuv422to32 = svga_line_yuv422to32_neon;
+    svga_render_simd_log("SVGA render: using NEON scanline kernels\n");
+#endif
+}
@@ -0,0 +1,281 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Standalone check and benchmark of the SVGA scanline kernels.
+ *
+ *          Runs every SSE2/AVX2/NEON kernel the host supports against
+ *          the C kernel of the same conversion over random spans of
+ *          every length up to a few vectors and every source offset,
+ *          then times each of them over full 1920 pixel lines. Exits
+ *          with a non-zero status on any mismatch.
+ *
+ *          Built with -DSVGA_SIMD_BENCH=ON, it is not part of the
+ *          emulator.
+ *
+ * Authors: agent, <agent@local>
+ *
+ *          Copyright 2025 agent.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <86box/pace.h>
+
+/*The kernels are static, so build them into this program.*/
+#include "vid_svga_render_simd.c"
+
+#define BENCH_WIDTH 1920
+#define BENCH_SLACK 64
+#define BENCH_SHORT 80
+#define BENCH_LINES 20000
+
+uint32_t *video_15to32 = NULL;
+uint32_t *video_16to32 = NULL;
+int       dopause      = 0; /* read by pace.c */
+
+static uint32_t bench_pal[256];
+static uint8_t  bench_mask;
+static int      bench_fmt;
+
+typedef void (*bench_func_t)(uint32_t *dst, const uint8_t *src, int count);
+
+typedef struct bench_kernel_t {
+    const char  *name;
+    const char  *isa;
+    int          bpp;  /* source bytes per pixel */
+    int          step; /* counts must be a multiple of this */
+    bench_func_t ref;
+    bench_func_t func;
+} bench_kernel_t;
+
+/*Same rounding as calc_15to32() and calc_16to32() in video.c.*/
+static uint32_t
+bench_calc_15to32(int c)
+{
+    int b = (int) (((double) (c & 31) / 31.0) * 255.0);
+    int g = (int) (((double) ((c >> 5) & 31) / 31.0) * 255.0);
+    int r = (int) (((double) ((c >> 10) & 31) / 31.0) * 255.0);
+
+    return b | (g << 8) | (r << 16) | 0xff000000;
+}
+
+static uint32_t
+bench_calc_16to32(int c)
+{
+    int b = (int) (((double) (c & 31) / 31.0) * 255.0);
+    int g = (int) (((double) ((c >> 5) & 63) / 63.0) * 255.0);
+    int r = (int) (((double) ((c >> 11) & 31) / 31.0) * 255.0);
+
+    return b | (g << 8) | (r << 16) | 0xff000000;
+}
+
+#define BENCH_WRAP_8(fn)                                                     \
+    static void bench_##fn(uint32_t *dst, const uint8_t *src, int count)     \
+    {                                                                        \
+        fn(dst, src, bench_pal, bench_mask, count);                          \
+    }
+#define BENCH_WRAP_16(fn)                                                    \
+    static void bench_##fn(uint32_t *dst, const uint8_t *src, int count)     \
+    {                                                                        \
+        fn(dst, (const uint16_t *) src, count);                              \
+    }
+#define BENCH_WRAP_24(fn)                                                    \
+    static void bench_##fn(uint32_t *dst, const uint8_t *src, int count)     \
+    {                                                                        \
+        fn(dst, src, count);                                                 \
+    }
+#define BENCH_WRAP_32(fn)                                                    \
+    static void bench_##fn(uint32_t *dst, const uint8_t *src, int count)     \
+    {                                                                        \
+        fn(dst, (const uint32_t *) src, count);                              \
+    }
+#define BENCH_WRAP_YUV(fn)                                                   \
+    static void bench_##fn(uint32_t *dst, const uint8_t *src, int count)     \
+    {                                                                        \
+        fn(dst, src, bench_fmt, count);                                      \
+    }
+
+BENCH_WRAP_8(svga_line_8to32_c)
+BENCH_WRAP_16(svga_line_15to32_c)
+BENCH_WRAP_16(svga_line_16to32_c)
+BENCH_WRAP_24(svga_line_24to32_c)
+BENCH_WRAP_32(svga_line_32to32_c)
+BENCH_WRAP_YUV(svga_line_yuv422to32_c)
+
+#ifdef SVGA_SIMD_X86
+BENCH_WRAP_16(svga_line_15to32_sse2)
+BENCH_WRAP_16(svga_line_16to32_sse2)
+BENCH_WRAP_32(svga_line_32to32_sse2)
+BENCH_WRAP_YUV(svga_line_yuv422to32_sse2)
+BENCH_WRAP_8(svga_line_8to32_avx2)
+BENCH_WRAP_16(svga_line_15to32_avx2)
+BENCH_WRAP_16(svga_line_16to32_avx2)
+BENCH_WRAP_24(svga_line_24to32_avx2)
+BENCH_WRAP_32(svga_line_32to32_avx2)
+#endif
+
+#ifdef SVGA_SIMD_NEON
+BENCH_WRAP_16(svga_line_15to32_neon)
+BENCH_WRAP_16(svga_line_16to32_neon)
+BENCH_WRAP_24(svga_line_24to32_neon)
+BENCH_WRAP_32(svga_line_32to32_neon)
+BENCH_WRAP_YUV(svga_line_yuv422to32_neon)
+#endif
+
+/*The C kernels themselves come first so they are timed as the baseline.*/
+static const bench_kernel_t bench_kernels[] = {
+    { "8to32",      "C",    1, 1, bench_svga_line_8to32_c,      bench_svga_line_8to32_c         },
+    { "15to32",     "C",    2, 1, bench_svga_line_15to32_c,     bench_svga_line_15to32_c        },
+    { "16to32",     "C",    2, 1, bench_svga_line_16to32_c,     bench_svga_line_16to32_c        },
+    { "24to32",     "C",    3, 1, bench_svga_line_24to32_c,     bench_svga_line_24to32_c        },
+    { "32to32",     "C",    4, 1, bench_svga_line_32to32_c,     bench_svga_line_32to32_c        },
+    { "yuv422to32", "C",    2, 2, bench_svga_line_yuv422to32_c, bench_svga_line_yuv422to32_c    },
+#ifdef SVGA_SIMD_X86
+    { "15to32",     "SSE2", 2, 1, bench_svga_line_15to32_c,     bench_svga_line_15to32_sse2     },
+    { "16to32",     "SSE2", 2, 1, bench_svga_line_16to32_c,     bench_svga_line_16to32_sse2     },
+    { "32to32",     "SSE2", 4, 1, bench_svga_line_32to32_c,     bench_svga_line_32to32_sse2     },
+    { "yuv422to32", "SSE2", 2, 2, bench_svga_line_yuv422to32_c, bench_svga_line_yuv422to32_sse2 },
+    { "8to32",      "AVX2", 1, 1, bench_svga_line_8to32_c,      bench_svga_line_8to32_avx2      },
+    { "15to32",     "AVX2", 2, 1, bench_svga_line_15to32_c,     bench_svga_line_15to32_avx2     },
+    { "16to32",     "AVX2", 2, 1, bench_svga_line_16to32_c,     bench_svga_line_16to32_avx2     },
+    { "24to32",     "AVX2", 3, 1, bench_svga_line_24to32_c,     bench_svga_line_24to32_avx2     },
+    { "32to32",     "AVX2", 4, 1, bench_svga_line_32to32_c,     bench_svga_line_32to32_avx2     },
+#endif
+#ifdef SVGA_SIMD_NEON
+    { "15to32",     "NEON", 2, 1, bench_svga_line_15to32_c,     bench_svga_line_15to32_neon     },
+    { "16to32",     "NEON", 2, 1, bench_svga_line_16to32_c,     bench_svga_line_16to32_neon     },
+    { "24to32",     "NEON", 3, 1, bench_svga_line_24to32_c,     bench_svga_line_24to32_neon     },
+    { "32to32",     "NEON", 4, 1, bench_svga_line_32to32_c,     bench_svga_line_32to32_neon     },
+    { "yuv422to32", "NEON", 2, 2, bench_svga_line_yuv422to32_c, bench_svga_line_yuv422to32_neon },
+#endif
+};
+
+static int
+bench_usable(const bench_kernel_t *k)
+{
+#ifdef SVGA_SIMD_X86
+    if (!strcmp(k->isa, "SSE2"))
+        return svga_cpu_has_sse2();
+    if (!strcmp(k->isa, "AVX2"))
+        return svga_cpu_has_avx2();
+#endif
+
+    return 1;
+}
+
+/*The YUV kernels are checked in every layout, the others once.*/
+static int
+bench_formats(const bench_kernel_t *k)
+{
+    return (k->step == 2) ? 8 : 1;
+}
+
+static int
+bench_check(const bench_kernel_t *k, const uint8_t *src, uint32_t *ref, uint32_t *out)
+{
+    int fails = 0;
+
+    for (int fmt = 0; fmt < bench_formats(k); fmt++) {
+        bench_fmt = fmt;
+
+        for (int off = 0; off < 8; off++) {
+            for (int count = 0; count <= BENCH_SHORT; count += k->step) {
+                const uint8_t *s = &src[off * k->bpp];
+
+                memset(ref, 0x55, (BENCH_SHORT + BENCH_SLACK) * sizeof(uint32_t));
+                memset(out, 0x55, (BENCH_SHORT + BENCH_SLACK) * sizeof(uint32_t));
+                k->ref(ref, s, count);
+                k->func(out, s, count);
+
+                /*Compare past the end too, to catch stores beyond the span.*/
+                if (memcmp(ref, out, (count + BENCH_SLACK) * sizeof(uint32_t))) {
+                    if (fails++ < 4)
+                        printf("  %s %s: mismatch, format %i offset %i count %i\n", k->name, k->isa, fmt, off, count);
+                }
+            }
+        }
+    }
+
+    return fails;
+}
+
+static double
+bench_time(const bench_kernel_t *k, const uint8_t *src, uint32_t *out)
+{
+    uint64_t start;
+    uint64_t ns;
+
+    bench_fmt = 0;
+
+    /*Warm up the caches and the tables first.*/
+    for (int i = 0; i < 100; i++)
+        k->func(out, src, BENCH_WIDTH);
+
+    start = pace_time_ns();
+    for (int i = 0; i < BENCH_LINES; i++)
+        k->func(out, src, BENCH_WIDTH);
+    ns = pace_time_ns() - start;
+
+    return (double) ns / ((double) BENCH_LINES * BENCH_WIDTH);
+}
+
+int
+main(void)
+{
+    const int n     = sizeof(bench_kernels) / sizeof(bench_kernels[0]);
+    int       fails = 0;
+    uint8_t  *src;
+    uint32_t *ref;
+    uint32_t *out;
+
+    video_15to32 = malloc(4 * 65536);
+    video_16to32 = malloc(4 * 65536);
+    src          = malloc((BENCH_WIDTH + BENCH_SLACK) * 4);
+    ref          = malloc((BENCH_WIDTH + BENCH_SLACK) * sizeof(uint32_t));
+    out          = malloc((BENCH_WIDTH + BENCH_SLACK) * sizeof(uint32_t));
+    if (!video_15to32 || !video_16to32 || !src || !ref || !out) {
+        printf("Out of memory\n");
+        return 2;
+    }
+
+    for (int c = 0; c < 65536; c++) {
+        video_15to32[c] = bench_calc_15to32(c & 0x7fff);
+        video_16to32[c] = bench_calc_16to32(c);
+    }
+
+    srand(86);
+    for (int c = 0; c < 256; c++)
+        bench_pal[c] = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+    for (int c = 0; c < ((BENCH_WIDTH + BENCH_SLACK) * 4); c++)
+        src[c] = rand() & 0xff;
+    bench_mask = 0xff;
+
+    printf("%-12s %-5s %-8s %s\n", "Kernel", "ISA", "Check", "ns/pixel");
+    for (int i = 0; i < n; i++) {
+        const bench_kernel_t *k = &bench_kernels[i];
+        int                   f;
+
+        if (!bench_usable(k)) {
+            printf("%-12s %-5s %-8s\n", k->name, k->isa, "skipped");
+            continue;
+        }
+
+        f = (k->ref == k->func) ? 0 : bench_check(k, src, ref, out);
+        fails += f;
+        printf("%-12s %-5s %-8s %.3f\n", k->name, k->isa, f ? "FAIL" : "ok", bench_time(k, src, out));
+    }
+
+    free(out);
+    free(ref);
+    free(src);
+    free(video_16to32);
+    free(video_15to32);
+
+    return fails ? 1 : 0;
+}
@@ -1128,7 +1128,7 @@ banshee_status(banshee_t *banshee)
     int           fifo_entries = FIFO_ENTRIES;
     int           swap_count   = voodoo->swap_count;
     int           written      = voodoo->cmd_written + voodoo->cmd_written_fifo;
-    int           busy         = (written - voodoo->cmd_read) || (voodoo->cmdfifo_depth_rd != voodoo->cmdfifo_depth_wr) || (voodoo->cmdfifo_depth_rd_2 != voodoo->cmdfifo_depth_wr_2) || voodoo->render_voodoo_busy[0] || voodoo->render_voodoo_busy[1] || voodoo->render_voodoo_busy[2] || voodoo->render_voodoo_busy[3] || voodoo->voodoo_busy;
+    int           busy         = (written - voodoo->cmd_read) || (voodoo->cmdfifo_depth_rd != voodoo->cmdfifo_depth_wr) || (voodoo->cmdfifo_depth_rd_2 != voodoo->cmdfifo_depth_wr_2) || voodoo_render_busy(voodoo) || voodoo->voodoo_busy;
     uint32_t      ret          = 0;
 
     if (fifo_entries < 0x20)
@@ -2381,12 +2381,6 @@ banshee_hwcursor_draw(svga_t *svga, int displine)
     }
 }
 
-#define CLAMP(x)                      \
-    do {                              \
-        if ((x) & ~0xff)              \
-            x = ((x) < 0) ? 0 : 0xff; \
-    } while (0)
-
 #define DECODE_RGB565(buf)                                                                                     \
     do {                                                                                                       \
         int c;                                                                                                 \
@@ -2425,82 +2419,20 @@ banshee_hwcursor_draw(svga_t *svga, int displine)
         }                                                                                                               \
     } while (0)
 
-#define DECODE_YUYV422(buf)                                      \
-    do {                                                         \
-        int c;                                                   \
-        int wp = 0;                                              \
-                                                                 \
-        for (c = 0; c < voodoo->overlay.overlay_bytes; c += 4) { \
-            uint8_t y1, y2;                                      \
-            int8_t  Cr, Cb;                                      \
-            int     dR, dG, dB;                                  \
-            int     r, g, b;                                     \
-                                                                 \
-            y1 = src[0];                                         \
-            Cr = src[1] - 0x80;                                  \
-            y2 = src[2];                                         \
-            Cb = src[3] - 0x80;                                  \
-            src += 4;                                            \
-                                                                 \
-            dR = (359 * Cr) >> 8;                                \
-            dG = (88 * Cb + 183 * Cr) >> 8;                      \
-            dB = (453 * Cb) >> 8;                                \
-                                                                 \
-            r = y1 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y1 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y1 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-                                                                 \
-            r = y2 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y2 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y2 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-        }                                                        \
+#define DECODE_YUYV422(buf)                                                                             \
+    do {                                                                                                \
+        int groups = (voodoo->overlay.overlay_bytes + 3) >> 2;                                          \
+                                                                                                        \
+        svga_line_yuv422to32(buf, src, SVGA_YUV_V_FIRST | SVGA_YUV_BGR, groups << 1);                   \
+        src += groups << 2;                                                                             \
     } while (0)
 
-#define DECODE_UYUV422(buf)                                      \
-    do {                                                         \
-        int c;                                                   \
-        int wp = 0;                                              \
-                                                                 \
-        for (c = 0; c < voodoo->overlay.overlay_bytes; c += 4) { \
-            uint8_t y1, y2;                                      \
-            int8_t  Cr, Cb;                                      \
-            int     dR, dG, dB;                                  \
-            int     r, g, b;                                     \
-                                                                 \
-            Cr = src[0] - 0x80;                                  \
-            y1 = src[1];                                         \
-            Cb = src[2] - 0x80;                                  \
-            y2 = src[3];                                         \
-            src += 4;                                            \
-                                                                 \
-            dR = (359 * Cr) >> 8;                                \
-            dG = (88 * Cb + 183 * Cr) >> 8;                      \
-            dB = (453 * Cb) >> 8;                                \
-                                                                 \
-            r = y1 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y1 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y1 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-                                                                 \
-            r = y2 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y2 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y2 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-        }                                                        \
+#define DECODE_UYUV422(buf)                                                                             \
+    do {                                                                                                \
+        int groups = (voodoo->overlay.overlay_bytes + 3) >> 2;                                          \
+                                                                                                        \
+        svga_line_yuv422to32(buf, src, SVGA_YUV_Y_ODD | SVGA_YUV_V_FIRST | SVGA_YUV_BGR, groups << 1);  \
+        src += groups << 2;                                                                             \
     } while (0)
 
 #define OVERLAY_SAMPLE(buf)                                                      \
@@ -3888,10 +3820,15 @@ static const device_config_t banshee_sgram_config[] = {
         .file_filter    = NULL,
         .spinner        = { 0 },
         .selection      = {
-            { .description = "1", .value = 1 },
-            { .description = "2", .value = 2 },
-            { .description = "4", .value = 4 },
-            { .description = ""              }
+            { .description = "1",  .value =  1 },
+            { .description = "2",  .value =  2 },
+            { .description = "3",  .value =  3 },
+            { .description = "4",  .value =  4 },
+            { .description = "6",  .value =  6 },
+            { .description = "8",  .value =  8 },
+            { .description = "12", .value = 12 },
+            { .description = "16", .value = 16 },
+            { .description = ""                }
         },
         .bios           = { { 0 } }
     },
@@ -3965,10 +3902,15 @@ static const device_config_t banshee_sgram_16mbonly_config[] = {
         .file_filter    = NULL,
         .spinner        = { 0 },
         .selection      = {
-            { .description = "1", .value = 1 },
-            { .description = "2", .value = 2 },
-            { .description = "4", .value = 4 },
-            { .description = ""              }
+            { .description = "1",  .value =  1 },
+            { .description = "2",  .value =  2 },
+            { .description = "3",  .value =  3 },
+            { .description = "4",  .value =  4 },
+            { .description = "6",  .value =  6 },
+            { .description = "8",  .value =  8 },
+            { .description = "12", .value = 12 },
+            { .description = "16", .value = 16 },
+            { .description = ""                }
         },
         .bios           = { { 0 } }
     },
@@ -4042,10 +3984,15 @@ static const device_config_t banshee_sdram_config[] = {
         .file_filter    = NULL,
         .spinner        = { 0 },
         .selection      = {
-            { .description = "1", .value = 1 },
-            { .description = "2", .value = 2 },
-            { .description = "4", .value = 4 },
-            { .description = ""              }
+            { .description = "1",  .value =  1 },
+            { .description = "2",  .value =  2 },
+            { .description = "3",  .value =  3 },
+            { .description = "4",  .value =  4 },
+            { .description = "6",  .value =  6 },
+            { .description = "8",  .value =  8 },
+            { .description = "12", .value = 12 },
+            { .description = "16", .value = 16 },
+            { .description = ""                }
         },
         .bios           = { { 0 } }
     },
@@ -41,6 +41,9 @@
 #include <86box/vid_voodoo_regs.h>
 #include <86box/vid_voodoo_render.h>
 #include <86box/vid_voodoo_texture.h>
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#    include <immintrin.h>
+#endif
 
 #ifdef ENABLE_VOODOO_FIFO_LOG
 int voodoo_fifo_do_log = ENABLE_VOODOO_FIFO_LOG;
@@ -153,6 +156,52 @@ voodoo_cmdfifo_reg_writel(voodoo_t *voodoo, uint32_t addr, uint32_t val)
     voodoo_reg_writel(addr, val, voodoo);
     voodoo_queue_apply_reg(voodoo, addr, val);
 }
+/*Both ends of the FIFO spin briefly on the shared indices before falling
+  back to the events, as most stalls are shorter than an event round trip.
+  The FIFO thread adapts its spin length to how often spinning paid off.*/
+#define FIFO_SPIN_MIN  64
+#define FIFO_SPIN_MAX  4096
+#define FIFO_FULL_SPIN 1024
+
+static __inline void
+voodoo_cpu_relax(void)
+{
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static __inline int
+voodoo_fifo_has_work(voodoo_t *voodoo)
+{
+    return !FIFO_EMPTY || (voodoo->cmdfifo_enabled && voodoo->cmdfifo_depth_rd != voodoo->cmdfifo_depth_wr);
+}
+
+/*Returns non-zero if work turned up while spinning, in which case the FIFO
+  thread can skip sleeping on wake_fifo_thread.*/
+static int
+voodoo_fifo_spin_wait(voodoo_t *voodoo)
+{
+    int limit = voodoo->fifo_spin_limit;
+
+    for (int c = 0; c < limit; c++) {
+        if (!voodoo->fifo_thread_run)
+            return 0;
+        if (voodoo_fifo_has_work(voodoo)) {
+            if (limit < FIFO_SPIN_MAX)
+                voodoo->fifo_spin_limit = limit << 1;
+            return 1;
+        }
+        voodoo_cpu_relax();
+    }
+
+    if (limit > FIFO_SPIN_MIN)
+        voodoo->fifo_spin_limit = limit >> 1;
+    return 0;
+}
+
 void
 voodoo_wake_fifo_thread(voodoo_t *voodoo)
 {
@@ -187,15 +236,24 @@ voodoo_queue_command(voodoo_t *voodoo, uint32_t addr_type, uint32_t val)
     uint64_t      fifo_wait_spins = 0;
     int           fifo_wait_active = 0;
 
-    while (FIFO_FULL) {
+    if (FIFO_FULL) {
         if (voodoo->wait_stats_enabled) {
-            if (!fifo_wait_active) {
-                fifo_wait_active = 1;
-                fifo_wait_start  = plat_timer_read();
-                voodoo->fifo_full_waits++;
-            }
+            fifo_wait_active = 1;
+            fifo_wait_start  = plat_timer_read();
+            voodoo->fifo_full_waits++;
+        }
+        voodoo_wake_fifo_thread_now(voodoo);
+        /*The FIFO thread frees entries continuously while draining, so room
+          usually appears well before a 1 ms event wait would time out.*/
+        for (int c = 0; (c < FIFO_FULL_SPIN) && FIFO_FULL; c++) {
+            voodoo_cpu_relax();
             fifo_wait_spins++;
         }
+    }
+
+    while (FIFO_FULL) {
+        if (voodoo->wait_stats_enabled)
+            fifo_wait_spins++;
         thread_reset_event(voodoo->fifo_not_full_event);
         if (FIFO_FULL) {
             thread_wait_event(voodoo->fifo_not_full_event, 1); /*Wait for room in ringbuffer*/
@@ -209,15 +267,14 @@ voodoo_queue_command(voodoo_t *voodoo, uint32_t addr_type, uint32_t val)
         voodoo->fifo_full_spin_checks += fifo_wait_spins;
     }
 
-#ifdef _WIN32
-    /* Reset only after an empty signal to avoid heavy ResetEvent churn on Windows. */
+    /*Only reset after the FIFO thread has signalled empty, so the common
+      path is a plain store into the ring with no event calls. Everything
+      waiting on fifo_empty_event rechecks FIFO_EMPTY, so a stale set is
+      harmless.*/
     if (ATOMIC_LOAD(voodoo->fifo_empty_signaled)) {
         ATOMIC_STORE(voodoo->fifo_empty_signaled, 0);
         thread_reset_event(voodoo->fifo_empty_event);
     }
-#else
-    thread_reset_event(voodoo->fifo_empty_event);
-#endif
 
     fifo->val        = val;
     fifo->addr_type  = addr_type;
@@ -383,10 +440,14 @@ voodoo_fifo_thread(void *param)
 {
     voodoo_t *voodoo = (voodoo_t *) param;
 
+    pc_thread_setup(THREAD_ROLE_VOODOO);
+    voodoo->fifo_spin_limit = FIFO_SPIN_MIN;
     while (voodoo->fifo_thread_run) {
         thread_set_event(voodoo->fifo_not_full_event);
-        thread_wait_event(voodoo->wake_fifo_thread, -1);
-        thread_reset_event(voodoo->wake_fifo_thread);
+        if (!voodoo_fifo_spin_wait(voodoo)) {
+            thread_wait_event(voodoo->wake_fifo_thread, -1);
+            thread_reset_event(voodoo->wake_fifo_thread);
+        }
         voodoo->voodoo_busy = 1;
         while (!FIFO_EMPTY) {
             uint64_t      start_time = plat_timer_read();
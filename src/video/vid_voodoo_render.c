@@ -661,6 +661,510 @@ voodoo_tmu_fetch_and_blend(voodoo_t *voodoo, voodoo_params_t *params, voodoo_sta
 int voodoo_recomp = 0;
 #endif
 
+/*Pixels handled per step by voodoo_render_span_lanes().*/
+#define SPAN_LANES 4
+
+static inline int32_t
+voodoo_w_depth(int64_t w)
+{
+    int32_t w_depth;
+
+    if (w & 0xffff00000000)
+        w_depth = 0;
+    else if (!(w & 0xffff0000))
+        w_depth = 0xf001;
+    else {
+        int exp  = voodoo_fls((uint16_t) ((uint32_t) w >> 16));
+        int mant = (~(uint32_t) w >> (19 - exp)) & 0xfff;
+        w_depth  = (exp << 12) + mant + 1;
+        if (w_depth > 0xffff)
+            w_depth = 0xffff;
+    }
+
+    return w_depth;
+}
+
+static inline int
+voodoo_depth_pass(voodoo_params_t *params, int comp_depth, int old_depth)
+{
+    switch (depth_op) {
+        case DEPTHOP_NEVER:
+            return 0;
+        case DEPTHOP_LESSTHAN:
+            return comp_depth < old_depth;
+        case DEPTHOP_EQUAL:
+            return comp_depth == old_depth;
+        case DEPTHOP_LESSTHANEQUAL:
+            return comp_depth <= old_depth;
+        case DEPTHOP_GREATERTHAN:
+            return comp_depth > old_depth;
+        case DEPTHOP_NOTEQUAL:
+            return comp_depth != old_depth;
+        case DEPTHOP_GREATERTHANEQUAL:
+            return comp_depth >= old_depth;
+        default:
+            return 1;
+    }
+}
+
+/*Returns whether spans of this triangle can go through
+  voodoo_render_span_lanes(). That covers the whole pixel pipeline; only
+  the modes the per pixel path treats as fatal stay there, so they are
+  still reported.*/
+static int
+voodoo_span_lanes_ok(UNUSED(voodoo_t *voodoo), voodoo_params_t *params)
+{
+    if ((cca_localselect > CCA_LOCALSELECT_ITER_Z) || (a_sel > A_SEL_COLOR1) || (cc_mselect > CC_MSELECT_TEXRGB) || (cca_mselect > CCA_MSELECT_TEX) || (cc_add == 3))
+        return 0;
+
+    return 1;
+}
+
+static inline void
+voodoo_span_step(voodoo_params_t *params, voodoo_state_t *state)
+{
+    if (state->xdir > 0) {
+        state->ir += params->dRdX;
+        state->ig += params->dGdX;
+        state->ib += params->dBdX;
+        state->ia += params->dAdX;
+        state->z += params->dZdX;
+        state->tmu0_s += params->tmu[0].dSdX;
+        state->tmu0_t += params->tmu[0].dTdX;
+        state->tmu0_w += params->tmu[0].dWdX;
+        state->tmu1_s += params->tmu[1].dSdX;
+        state->tmu1_t += params->tmu[1].dTdX;
+        state->tmu1_w += params->tmu[1].dWdX;
+        state->w += params->dWdX;
+    } else {
+        state->ir -= params->dRdX;
+        state->ig -= params->dGdX;
+        state->ib -= params->dBdX;
+        state->ia -= params->dAdX;
+        state->z -= params->dZdX;
+        state->tmu0_s -= params->tmu[0].dSdX;
+        state->tmu0_t -= params->tmu[0].dTdX;
+        state->tmu0_w -= params->tmu[0].dWdX;
+        state->tmu1_s -= params->tmu[1].dSdX;
+        state->tmu1_t -= params->tmu[1].dTdX;
+        state->tmu1_w -= params->tmu[1].dWdX;
+        state->w -= params->dWdX;
+    }
+}
+
+/*Renders the span x..x2 SPAN_LANES pixels at a time. Stipple, depth
+  test, texture fetch, chroma key and alpha mask are done per pixel, the
+  colour and alpha combine, clamping and inversion run over all lanes at
+  once with the mode decisions hoisted out of the lane loops, so the
+  compiler can turn them into SSE2/NEON code. Fog, alpha test, alpha
+  blending, dithering and the writes follow per pixel again. This is the
+  C pipeline used when the recompiler is off or unavailable; the
+  recompiled code still draws one pixel per iteration.*/
+static void
+voodoo_render_span_lanes(voodoo_t *voodoo, voodoo_params_t *params, voodoo_state_t *state, int x, int x2, int real_y, int texels, int odd_even)
+{
+    uint16_t *fb_mem  = state->fb_mem;
+    uint16_t *aux_mem = state->aux_mem;
+    int       left    = ((state->xdir > 0) ? (x2 - x) : (x - x2)) + 1;
+
+    while (left > 0) {
+        int     n                         = (left < SPAN_LANES) ? left : SPAN_LANES;
+        int     lx[SPAN_LANES]            = { 0 };
+        int     live[SPAN_LANES]          = { 0 };
+        int32_t depth[SPAN_LANES]         = { 0 };
+        int32_t wdepth[SPAN_LANES]        = { 0 };
+        int32_t lane_z[SPAN_LANES]        = { 0 };
+        int32_t lane_ia[SPAN_LANES]       = { 0 };
+        int64_t lane_w[SPAN_LANES]        = { 0 };
+        int     iter_r[SPAN_LANES]        = { 0 };
+        int     iter_g[SPAN_LANES]        = { 0 };
+        int     iter_b[SPAN_LANES]        = { 0 };
+        int     iter_a[SPAN_LANES]        = { 0 };
+        int     iter_z[SPAN_LANES]        = { 0 };
+        int     tex_r[SPAN_LANES]         = { 0 };
+        int     tex_g[SPAN_LANES]         = { 0 };
+        int     tex_b[SPAN_LANES]         = { 0 };
+        int     tex_a[SPAN_LANES]         = { 0 };
+        int     cother_r[SPAN_LANES]      = { 0 };
+        int     cother_g[SPAN_LANES]      = { 0 };
+        int     cother_b[SPAN_LANES]      = { 0 };
+        int     aother[SPAN_LANES]        = { 0 };
+        int     clocal_r[SPAN_LANES];
+        int     clocal_g[SPAN_LANES];
+        int     clocal_b[SPAN_LANES];
+        int     alocal[SPAN_LANES];
+        int     col_r[SPAN_LANES];
+        int     col_g[SPAN_LANES];
+        int     col_b[SPAN_LANES];
+        int     col_a[SPAN_LANES];
+        int     msel_r[SPAN_LANES];
+        int     msel_g[SPAN_LANES];
+        int     msel_b[SPAN_LANES];
+        int     msel_a[SPAN_LANES];
+        int     i;
+
+        /*Per pixel: everything that can reject a pixel before the combine,
+          and the texture fetch.*/
+        for (i = 0; i < n; i++) {
+            lx[i] = x;
+            voodoo->pixel_count[odd_even]++;
+            voodoo->texel_count[odd_even] += texels;
+            voodoo->fbiPixelsIn++;
+
+            do {
+                int32_t new_depth;
+
+                if (params->fbzMode & FBZ_STIPPLE) {
+                    if (params->fbzMode & FBZ_STIPPLE_PATT) {
+                        if (!(state->stipple & (1 << (((real_y & 3) << 3) | (~x & 7)))))
+                            break;
+                    } else {
+                        state->stipple = (state->stipple << 1) | (state->stipple >> 31);
+                        if (!(state->stipple & 0x80000000))
+                            break;
+                    }
+                }
+
+                wdepth[i] = voodoo_w_depth(state->w);
+
+                if (params->fbzMode & FBZ_W_BUFFER)
+                    new_depth = wdepth[i];
+                else
+                    new_depth = CLAMP16(state->z >> 12);
+
+                if (params->fbzMode & FBZ_DEPTH_BIAS)
+                    new_depth = CLAMP16(new_depth + (int16_t) params->zaColor);
+
+                if (params->fbzMode & FBZ_DEPTH_ENABLE) {
+                    int      x_tiled   = (x & 63) | ((x >> 6) * 128 * 32 / 2);
+                    uint16_t old_depth = params->aux_tiled ? aux_mem[x_tiled] : aux_mem[x];
+
+                    if (!voodoo_depth_pass(params, (params->fbzMode & FBZ_DEPTH_SOURCE) ? (params->zaColor & 0xffff) : new_depth, old_depth)) {
+                        voodoo->fbiZFuncFail++;
+                        break;
+                    }
+                }
+                depth[i] = new_depth;
+
+                if (params->fbzColorPath & FBZCP_TEXTURE_ENABLED) {
+                    if ((params->textureMode[0] & TEXTUREMODE_LOCAL_MASK) == TEXTUREMODE_LOCAL || !voodoo->dual_tmus) {
+                        voodoo_tmu_fetch(voodoo, params, state, 0, x);
+                    } else if ((params->textureMode[0] & TEXTUREMODE_MASK) == TEXTUREMODE_PASSTHROUGH) {
+                        voodoo_tmu_fetch(voodoo, params, state, 1, x);
+
+                        state->tex_r[0] = state->tex_r[1];
+                        state->tex_g[0] = state->tex_g[1];
+                        state->tex_b[0] = state->tex_b[1];
+                        state->tex_a[0] = state->tex_a[1];
+                    } else
+                        voodoo_tmu_fetch_and_blend(voodoo, params, state, x);
+                }
+
+                if (voodoo->trexInit1[0] & (1 << 18)) {
+                    state->tex_r[0] = state->tex_g[0] = 0;
+                    state->tex_b[0]                   = voodoo->tmuConfig;
+                }
+
+                iter_r[i]  = CLAMP(state->ir >> 12);
+                iter_g[i]  = CLAMP(state->ig >> 12);
+                iter_b[i]  = CLAMP(state->ib >> 12);
+                iter_a[i]  = CLAMP(state->ia >> 12);
+                iter_z[i]  = CLAMP(state->z >> 20);
+                tex_r[i]   = state->tex_r[0];
+                tex_g[i]   = state->tex_g[0];
+                tex_b[i]   = state->tex_b[0];
+                tex_a[i]   = state->tex_a[0];
+                lane_z[i]  = state->z;
+                lane_ia[i] = state->ia;
+                lane_w[i]  = state->w;
+
+                switch (_rgb_sel) {
+                    case CC_LOCALSELECT_ITER_RGB:
+                        cother_r[i] = iter_r[i];
+                        cother_g[i] = iter_g[i];
+                        cother_b[i] = iter_b[i];
+                        break;
+                    case CC_LOCALSELECT_TEX:
+                        cother_r[i] = tex_r[i];
+                        cother_g[i] = tex_g[i];
+                        cother_b[i] = tex_b[i];
+                        break;
+                    case CC_LOCALSELECT_COLOR1:
+                        cother_r[i] = (params->color1 >> 16) & 0xff;
+                        cother_g[i] = (params->color1 >> 8) & 0xff;
+                        cother_b[i] = params->color1 & 0xff;
+                        break;
+                    default: /*Linear Frame Buffer, which is zero here*/
+                        cother_r[i] = cother_g[i] = cother_b[i] = 0;
+                        break;
+                }
+
+                if ((params->fbzMode & FBZ_CHROMAKEY) && (cother_r[i] == params->chromaKey_r) &&
+                    (cother_g[i] == params->chromaKey_g) && (cother_b[i] == params->chromaKey_b)) {
+                    voodoo->fbiChromaFail++;
+                    break;
+                }
+
+                switch (a_sel) {
+                    case A_SEL_ITER_A:
+                        aother[i] = iter_a[i];
+                        break;
+                    case A_SEL_TEX:
+                        aother[i] = tex_a[i];
+                        break;
+                    default:
+                        aother[i] = (params->color1 >> 24) & 0xff;
+                        break;
+                }
+
+                if ((params->fbzMode & FBZ_ALPHA_MASK) && !(aother[i] & 1))
+                    break;
+
+                live[i] = 1;
+            } while (0);
+
+            voodoo_span_step(params, state);
+            x += state->xdir;
+        }
+
+        /*Colour and alpha combine over all lanes.*/
+        for (i = 0; i < SPAN_LANES; i++) {
+            int sel = cc_localselect_override ? (tex_a[i] & 0x80) : cc_localselect;
+
+            clocal_r[i] = sel ? ((params->color0 >> 16) & 0xff) : iter_r[i];
+            clocal_g[i] = sel ? ((params->color0 >> 8) & 0xff) : iter_g[i];
+            clocal_b[i] = sel ? (params->color0 & 0xff) : iter_b[i];
+        }
+
+        switch (cca_localselect) {
+            case CCA_LOCALSELECT_ITER_A:
+                for (i = 0; i < SPAN_LANES; i++)
+                    alocal[i] = iter_a[i];
+                break;
+            case CCA_LOCALSELECT_COLOR0:
+                for (i = 0; i < SPAN_LANES; i++)
+                    alocal[i] = (params->color0 >> 24) & 0xff;
+                break;
+            default:
+                for (i = 0; i < SPAN_LANES; i++)
+                    alocal[i] = iter_z[i];
+                break;
+        }
+
+        for (i = 0; i < SPAN_LANES; i++) {
+            col_r[i] = cc_zero_other ? 0 : cother_r[i];
+            col_g[i] = cc_zero_other ? 0 : cother_g[i];
+            col_b[i] = cc_zero_other ? 0 : cother_b[i];
+            col_a[i] = cca_zero_other ? 0 : aother[i];
+        }
+
+        if (cc_sub_clocal) {
+            for (i = 0; i < SPAN_LANES; i++) {
+                col_r[i] -= clocal_r[i];
+                col_g[i] -= clocal_g[i];
+                col_b[i] -= clocal_b[i];
+            }
+        }
+
+        if (cca_sub_clocal) {
+            for (i = 0; i < SPAN_LANES; i++)
+                col_a[i] -= alocal[i];
+        }
+
+        switch (cc_mselect) {
+            case CC_MSELECT_ZERO:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_r[i] = msel_g[i] = msel_b[i] = 0;
+                break;
+            case CC_MSELECT_CLOCAL:
+                for (i = 0; i < SPAN_LANES; i++) {
+                    msel_r[i] = clocal_r[i];
+                    msel_g[i] = clocal_g[i];
+                    msel_b[i] = clocal_b[i];
+                }
+                break;
+            case CC_MSELECT_AOTHER:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_r[i] = msel_g[i] = msel_b[i] = aother[i];
+                break;
+            case CC_MSELECT_ALOCAL:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_r[i] = msel_g[i] = msel_b[i] = alocal[i];
+                break;
+            case CC_MSELECT_TEX:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_r[i] = msel_g[i] = msel_b[i] = tex_a[i];
+                break;
+            default:
+                for (i = 0; i < SPAN_LANES; i++) {
+                    msel_r[i] = tex_r[i];
+                    msel_g[i] = tex_g[i];
+                    msel_b[i] = tex_b[i];
+                }
+                break;
+        }
+
+        switch (cca_mselect) {
+            case CCA_MSELECT_ZERO:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_a[i] = 0;
+                break;
+            case CCA_MSELECT_AOTHER:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_a[i] = aother[i];
+                break;
+            case CCA_MSELECT_TEX:
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_a[i] = tex_a[i];
+                break;
+            default: /*ALOCAL and ALOCAL2*/
+                for (i = 0; i < SPAN_LANES; i++)
+                    msel_a[i] = alocal[i];
+                break;
+        }
+
+        for (i = 0; i < SPAN_LANES; i++) {
+            int inv   = cc_reverse_blend ? 0 : 0xff;
+            int inv_a = cca_reverse_blend ? 0 : 0xff;
+
+            col_r[i] = (col_r[i] * ((msel_r[i] ^ inv) + 1)) >> 8;
+            col_g[i] = (col_g[i] * ((msel_g[i] ^ inv) + 1)) >> 8;
+            col_b[i] = (col_b[i] * ((msel_b[i] ^ inv) + 1)) >> 8;
+            col_a[i] = (col_a[i] * ((msel_a[i] ^ inv_a) + 1)) >> 8;
+        }
+
+        if (cc_add == CC_ADD_CLOCAL) {
+            for (i = 0; i < SPAN_LANES; i++) {
+                col_r[i] += clocal_r[i];
+                col_g[i] += clocal_g[i];
+                col_b[i] += clocal_b[i];
+            }
+        } else if (cc_add == CC_ADD_ALOCAL) {
+            for (i = 0; i < SPAN_LANES; i++) {
+                col_r[i] += alocal[i];
+                col_g[i] += alocal[i];
+                col_b[i] += alocal[i];
+            }
+        }
+
+        if (cca_add) {
+            for (i = 0; i < SPAN_LANES; i++)
+                col_a[i] += alocal[i];
+        }
+
+        for (i = 0; i < SPAN_LANES; i++) {
+            int inv   = cc_invert_output ? 0xff : 0;
+            int inv_a = cca_invert_output ? 0xff : 0;
+
+            col_r[i] = CLAMP(col_r[i]) ^ inv;
+            col_g[i] = CLAMP(col_g[i]) ^ inv;
+            col_b[i] = CLAMP(col_b[i]) ^ inv;
+            col_a[i] = CLAMP(col_a[i]) ^ inv_a;
+        }
+
+        /*Fog, alpha test and blending, dither and write out the pixels
+          that are still live.*/
+        for (i = 0; i < n; i++) {
+            int      px      = lx[i];
+            int      x_tiled = (px & 63) | ((px >> 6) * 128 * 32 / 2);
+            int      w_depth = wdepth[i];
+            int      src_r   = col_r[i];
+            int      src_g   = col_g[i];
+            int      src_b   = col_b[i];
+            int      src_a   = col_a[i];
+            int      colbfog_r;
+            int      colbfog_g;
+            int      colbfog_b;
+            uint8_t  dest_r;
+            uint8_t  dest_g;
+            uint8_t  dest_b;
+            uint8_t  dest_a;
+            uint16_t dat;
+
+            if (!live[i])
+                continue;
+
+            dat    = params->col_tiled ? fb_mem[x_tiled] : fb_mem[px];
+            dest_r = (dat >> 8) & 0xf8;
+            dest_g = (dat >> 3) & 0xfc;
+            dest_b = (dat << 3) & 0xf8;
+            dest_r |= (dest_r >> 5);
+            dest_g |= (dest_g >> 6);
+            dest_b |= (dest_b >> 5);
+            dest_a = 0xff;
+
+            if (params->fbzMode & FBZ_ALPHA_ENABLE)
+                dest_a = params->aux_tiled ? aux_mem[x_tiled] : aux_mem[px];
+
+            colbfog_r = src_r;
+            colbfog_g = src_g;
+            colbfog_b = src_b;
+
+            if (params->fogMode & FOG_ENABLE)
+                APPLY_FOG(src_r, src_g, src_b, lane_z[i], lane_ia[i], lane_w[i]);
+
+            if (params->alphaMode & 1)
+                ALPHA_TEST(src_a);
+
+            if (params->alphaMode & (1 << 4)) {
+                if (dithersub && !dither2x2 && voodoo->dithersub_enabled) {
+                    dest_r = dithersub_rb[dest_r][real_y & 3][px & 3];
+                    dest_g = dithersub_g[dest_g][real_y & 3][px & 3];
+                    dest_b = dithersub_rb[dest_b][real_y & 3][px & 3];
+                }
+                if (dithersub && dither2x2 && voodoo->dithersub_enabled) {
+                    dest_r = dithersub_rb2x2[dest_r][real_y & 1][px & 1];
+                    dest_g = dithersub_g2x2[dest_g][real_y & 1][px & 1];
+                    dest_b = dithersub_rb2x2[dest_b][real_y & 1][px & 1];
+                }
+                ALPHA_BLEND(src_r, src_g, src_b, src_a);
+
+                src_a = (((dest_aafunc == 4) ? dest_a * 256 : 0) + ((src_aafunc == 4) ? src_a * 256 : 0)) >> 8;
+            }
+
+            if (dither) {
+                if (dither2x2) {
+                    src_r = dither_rb2x2[src_r][real_y & 1][px & 1];
+                    src_g = dither_g2x2[src_g][real_y & 1][px & 1];
+                    src_b = dither_rb2x2[src_b][real_y & 1][px & 1];
+                } else {
+                    src_r = dither_rb[src_r][real_y & 3][px & 3];
+                    src_g = dither_g[src_g][real_y & 3][px & 3];
+                    src_b = dither_rb[src_b][real_y & 3][px & 3];
+                }
+            } else {
+                src_r >>= 3;
+                src_g >>= 2;
+                src_b >>= 3;
+            }
+
+            if (params->fbzMode & FBZ_RGB_WMASK) {
+                if (params->col_tiled)
+                    fb_mem[x_tiled] = src_b | (src_g << 5) | (src_r << 11);
+                else
+                    fb_mem[px] = src_b | (src_g << 5) | (src_r << 11);
+            }
+            if ((params->fbzMode & (FBZ_DEPTH_WMASK | FBZ_ALPHA_ENABLE)) == (FBZ_DEPTH_WMASK | FBZ_ALPHA_ENABLE)) {
+                if (params->aux_tiled)
+                    aux_mem[x_tiled] = src_a;
+                else
+                    aux_mem[px] = src_a;
+            } else if ((params->fbzMode & (FBZ_DEPTH_WMASK | FBZ_DEPTH_ENABLE)) == (FBZ_DEPTH_WMASK | FBZ_DEPTH_ENABLE)) {
+                if (params->aux_tiled)
+                    aux_mem[x_tiled] = depth[i];
+                else
+                    aux_mem[px] = depth[i];
+            }
+
+            voodoo->fbiPixelsOut++;
+skip_pixel:
+            ;
+        }
+
+        left -= n;
+    }
+}
+
 static void
 voodoo_half_triangle(voodoo_t *voodoo, voodoo_params_t *params, voodoo_state_t *state, int ystart, int yend, int odd_even)
 {
@@ -691,6 +1195,7 @@ voodoo_half_triangle(voodoo_t *voodoo, voodoo_params_t *params, voodoo_state_t *
     int dither                  = params->fbzMode & FBZ_DITHER;*/
 #endif
     int texels;
+    int span_lanes = voodoo_span_lanes_ok(voodoo, params);
 #ifndef NO_CODEGEN
     uint8_t (*voodoo_draw)(voodoo_state_t * state, voodoo_params_t * params, int x, int real_y);
 #endif
@@ -827,11 +1332,10 @@ voodoo_half_triangle(voodoo_t *voodoo, voodoo_params_t *params, voodoo_state_t *
         else
             real_y >>= 4;
 
-        if (SLI_ENABLED) {
-            if (((real_y >> 1) & voodoo->odd_even_mask) != odd_even)
-                goto next_line;
-        } else {
-            if ((real_y & voodoo->odd_even_mask) != odd_even)
+        if (voodoo->render_threads > 1) {
+            unsigned band = (unsigned) (SLI_ENABLED ? (real_y >> 1) : real_y) >> VOODOO_RENDER_BAND_SHIFT;
+
+            if ((band % voodoo->render_threads) != (unsigned) odd_even)
                 goto next_line;
         }
 
@@ -938,6 +1442,9 @@ voodoo_half_triangle(voodoo_t *voodoo, voodoo_params_t *params, voodoo_state_t *
             voodoo_draw(state, params, x, real_y);
         } else
 #endif
+        if (span_lanes)
+            voodoo_render_span_lanes(voodoo, params, state, x, x2, real_y, texels, odd_even);
+        else
             do {
                 int x_tiled = (x & 63) | ((x >> 6) * 128 * 32 / 2);
                 start_x     = x;
@@ -980,17 +1487,7 @@ voodoo_half_triangle(voodoo_t *voodoo, voodoo_params_t *params, voodoo_state_t *
                     int32_t  new_depth;
                     int32_t  w_depth;
 
-                    if (state->w & 0xffff00000000)
-                        w_depth = 0;
-                    else if (!(state->w & 0xffff0000))
-                        w_depth = 0xf001;
-                    else {
-                        int exp  = voodoo_fls((uint16_t) ((uint32_t) state->w >> 16));
-                        int mant = (~(uint32_t) state->w >> (19 - exp)) & 0xfff;
-                        w_depth  = (exp << 12) + mant + 1;
-                        if (w_depth > 0xffff)
-                            w_depth = 0xffff;
-                    }
+                    w_depth = voodoo_w_depth(state->w);
 
                     if (params->fbzMode & FBZ_STIPPLE) {
                         if (params->fbzMode & FBZ_STIPPLE_PATT) {
@@ -1584,10 +2081,13 @@ voodoo_render_log("voodoo_triangle %i %i %i : vA %f, %f  vB %f, %f  vC %f, %f f
 }
 
 static void
-render_thread(void *param, int odd_even)
+render_thread(void *param)
 {
-    voodoo_t *voodoo = (voodoo_t *) param;
+    const struct voodoo_render_slot_t *slot     = (struct voodoo_render_slot_t *) param;
+    voodoo_t                          *voodoo   = slot->voodoo;
+    int                                odd_even = slot->index;
 
+    pc_thread_setup(THREAD_ROLE_VOODOO);
     while (voodoo->render_thread_run[odd_even]) {
         thread_set_event(voodoo->render_not_full_event[odd_even]);
         thread_wait_event(voodoo->wake_render_thread[odd_even], -1);
@@ -1615,24 +2115,44 @@ render_thread(void *param, int odd_even)
 }
 
 void
-voodoo_render_thread_1(void *param)
+voodoo_render_threads_init(voodoo_t *voodoo)
 {
-    render_thread(param, 0);
-}
-void
-voodoo_render_thread_2(void *param)
-{
-    render_thread(param, 1);
+    if (voodoo->render_threads < 1)
+        voodoo->render_threads = 1;
+    else if (voodoo->render_threads > VOODOO_MAX_RENDER_THREADS)
+        voodoo->render_threads = VOODOO_MAX_RENDER_THREADS;
+
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        voodoo->render_slot[c].voodoo    = voodoo;
+        voodoo->render_slot[c].index     = c;
+        voodoo->wake_render_thread[c]    = thread_create_event();
+        voodoo->render_not_full_event[c] = thread_create_event();
+        voodoo->render_thread_run[c]     = 1;
+        voodoo->render_thread[c]         = thread_create(render_thread, &voodoo->render_slot[c]);
+    }
 }
+
 void
-voodoo_render_thread_3(void *param)
+voodoo_render_threads_close(voodoo_t *voodoo)
 {
-    render_thread(param, 2);
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        voodoo->render_thread_run[c] = 0;
+        thread_set_event(voodoo->wake_render_thread[c]);
+        thread_wait(voodoo->render_thread[c]);
+        thread_destroy_event(voodoo->wake_render_thread[c]);
+        thread_destroy_event(voodoo->render_not_full_event[c]);
+    }
 }
-void
-voodoo_render_thread_4(void *param)
+
+static int
+voodoo_render_full(voodoo_t *voodoo)
 {
-    render_thread(param, 3);
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        if (PARAM_FULL(c))
+            return 1;
+    }
+
+    return 0;
 }
 
 void
@@ -1640,22 +2160,13 @@ voodoo_queue_triangle(voodoo_t *voodoo, voodoo_params_t *params)
 {
     voodoo_params_t *params_new = &voodoo->params_buffer[voodoo->params_write_idx & PARAM_MASK];
 
-    while (PARAM_FULL(0) || (voodoo->render_threads >= 2 && PARAM_FULL(1)) || (voodoo->render_threads == 4 && (PARAM_FULL(2) || PARAM_FULL(3)))) {
-        thread_reset_event(voodoo->render_not_full_event[0]);
-        if (voodoo->render_threads >= 2)
-            thread_reset_event(voodoo->render_not_full_event[1]);
-        if (voodoo->render_threads == 4) {
-            thread_reset_event(voodoo->render_not_full_event[2]);
-            thread_reset_event(voodoo->render_not_full_event[3]);
+    while (voodoo_render_full(voodoo)) {
+        for (int c = 0; c < voodoo->render_threads; c++)
+            thread_reset_event(voodoo->render_not_full_event[c]);
+        for (int c = 0; c < voodoo->render_threads; c++) {
+            if (PARAM_FULL(c))
+                thread_wait_event(voodoo->render_not_full_event[c], -1); /*Wait for room in ringbuffer*/
         }
-        if (PARAM_FULL(0))
-            thread_wait_event(voodoo->render_not_full_event[0], -1); /*Wait for room in ringbuffer*/
-        if (voodoo->render_threads >= 2 && PARAM_FULL(1))
-            thread_wait_event(voodoo->render_not_full_event[1], -1); /*Wait for room in ringbuffer*/
-        if (voodoo->render_threads == 4 && PARAM_FULL(2))
-            thread_wait_event(voodoo->render_not_full_event[2], -1); /*Wait for room in ringbuffer*/
-        if (voodoo->render_threads == 4 && PARAM_FULL(3))
-            thread_wait_event(voodoo->render_not_full_event[3], -1); /*Wait for room in ringbuffer*/
     }
 
     voodoo_use_texture(voodoo, params, 0);
@@ -1666,6 +2177,10 @@ voodoo_queue_triangle(voodoo_t *voodoo, voodoo_params_t *params)
 
     voodoo->params_write_idx++;
 
-    if (PARAM_ENTRIES(0) < 4 || (voodoo->render_threads >= 2 && PARAM_ENTRIES(1) < 4) || (voodoo->render_threads == 4 && (PARAM_ENTRIES(2) < 4 || PARAM_ENTRIES(3) < 4)))
-        voodoo_wake_render_thread(voodoo);
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        if (PARAM_ENTRIES(c) < 4) {
+            voodoo_wake_render_thread(voodoo);
+            break;
+        }
+    }
 }
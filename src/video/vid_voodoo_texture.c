@@ -237,6 +237,145 @@ voodoo_recalc_tex3(voodoo_t *voodoo, int tmu)
 
 #define makergba(r, g, b, a) ((b) | ((g) << 8) | ((r) << 16) | ((a) << 24))
 
+/*Returns whether any render thread still has queued triangles using this
+  cache entry.*/
+static int
+voodoo_texture_in_use(voodoo_t *voodoo, int tmu, int entry)
+{
+    const texture_t *tex = &voodoo->texture_cache[tmu][entry];
+
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        if (tex->refcount != tex->refcount_r[c])
+            return 1;
+    }
+
+    return 0;
+}
+
+/*Decoded size of a full mipmap chain, see texture_offset[].*/
+#define TEX_ENTRY_SIZE ((256 * 256 + 256 * 256 + 128 * 128 + 64 * 64 + 32 * 32 + 16 * 16 + 8 * 8 + 4 * 4 + 2 * 2) * 4)
+
+static inline int
+voodoo_tex_hash(uint32_t base, uint32_t tlod, uint32_t palette_checksum)
+{
+    uint32_t h = (base >> 3) ^ (tlod * 0x9e3779b1) ^ palette_checksum;
+
+    return (h ^ (h >> 16)) & (TEX_HASH_SIZE - 1);
+}
+
+/*Gets the texture memory pages one address range of a cache entry was
+  decoded from, returns 0 if the range is unused.*/
+static int
+voodoo_tex_range_pages(voodoo_t *voodoo, const texture_t *tex, int d, int *first, int *last)
+{
+    if (tex->addr_end[d] == 0)
+        return 0;
+
+    *first = (tex->addr_start[d] & voodoo->texture_mask) >> TEX_DIRTY_SHIFT;
+    *last  = (tex->addr_end[d] & voodoo->texture_mask) >> TEX_DIRTY_SHIFT;
+    if (*last < *first)
+        *last = voodoo->texture_mask >> TEX_DIRTY_SHIFT;
+    if (*last >= TEX_PAGES)
+        *last = TEX_PAGES - 1;
+
+    return 1;
+}
+
+/*Adds a cache entry to the lookup hash and to the reverse index of the
+  pages it was decoded from.*/
+static void
+voodoo_tex_link(voodoo_t *voodoo, int tmu, int c)
+{
+    texture_t *tex   = &voodoo->texture_cache[tmu][c];
+    int        words = voodoo->texture_cache_size >> 6;
+    int        first;
+    int        last;
+
+    tex->hash                            = voodoo_tex_hash(tex->base, tex->tLOD, tex->palette_checksum);
+    tex->hash_next                       = voodoo->texture_hash[tmu][tex->hash];
+    voodoo->texture_hash[tmu][tex->hash] = c;
+
+    for (int d = 0; d < 4; d++) {
+        if (!voodoo_tex_range_pages(voodoo, tex, d, &first, &last))
+            continue;
+
+        for (int p = first; p <= last; p++) {
+            voodoo->texture_users[tmu][(p * words) + (c >> 6)] |= (1ULL << (c & 63));
+            voodoo->texture_present[tmu][p] = 1;
+        }
+    }
+}
+
+/*Removes a cache entry from the hash and the reverse index, and marks it
+  free.*/
+static void
+voodoo_tex_unlink(voodoo_t *voodoo, int tmu, int c)
+{
+    texture_t *tex   = &voodoo->texture_cache[tmu][c];
+    int       *prev  = &voodoo->texture_hash[tmu][tex->hash];
+    int        words = voodoo->texture_cache_size >> 6;
+    int        first;
+    int        last;
+
+    while (*prev != -1) {
+        if (*prev == c) {
+            *prev = tex->hash_next;
+            break;
+        }
+        prev = &voodoo->texture_cache[tmu][*prev].hash_next;
+    }
+
+    for (int d = 0; d < 4; d++) {
+        if (!voodoo_tex_range_pages(voodoo, tex, d, &first, &last))
+            continue;
+
+        for (int p = first; p <= last; p++) {
+            uint64_t *users = &voodoo->texture_users[tmu][p * words];
+            uint64_t  any   = 0;
+
+            users[c >> 6] &= ~(1ULL << (c & 63));
+            for (int w = 0; w < words; w++)
+                any |= users[w];
+            voodoo->texture_present[tmu][p] = !!any;
+        }
+    }
+
+    tex->base = -1;
+}
+
+void
+voodoo_texture_cache_init(voodoo_t *voodoo)
+{
+    int size = TEX_CACHE_MAX;
+
+    /*Banshee and later share texture memory with the frame buffer and set
+      texture_size later, give them the largest cache.*/
+    if (voodoo->texture_size)
+        size = MIN(MAX(voodoo->texture_size * 32, TEX_CACHE_MIN), TEX_CACHE_MAX);
+    voodoo->texture_cache_size = size;
+
+    for (int tmu = 0; tmu < 2; tmu++) {
+        voodoo->texture_cache[tmu] = calloc(size, sizeof(texture_t));
+        voodoo->texture_users[tmu] = calloc((size_t) TEX_PAGES * (size >> 6), sizeof(uint64_t));
+
+        for (int c = 0; c < size; c++)
+            voodoo->texture_cache[tmu][c].base = -1; /*invalid*/
+        for (int c = 0; c < TEX_HASH_SIZE; c++)
+            voodoo->texture_hash[tmu][c] = -1;
+    }
+}
+
+void
+voodoo_texture_cache_close(voodoo_t *voodoo)
+{
+    for (int tmu = 0; tmu < 2; tmu++) {
+        for (int c = 0; c < voodoo->texture_cache_size; c++)
+            free(voodoo->texture_cache[tmu][c].data);
+        free(voodoo->texture_cache[tmu]);
+        free(voodoo->texture_users[tmu]);
+    }
+}
+
 void
 voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
 {
@@ -244,7 +383,6 @@ voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
     int      lod_min;
     int      lod_max;
     uint32_t addr = 0;
-    uint32_t addr_end;
     uint32_t palette_checksum;
 
     lod_min = (params->tLOD[tmu] >> 2) & 15;
@@ -270,7 +408,8 @@ voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
         addr = params->texBaseAddr[tmu];
 
     /*Try to find texture in cache*/
-    for (c = 0; c < TEX_CACHE_MAX; c++) {
+    c = voodoo->texture_hash[tmu][voodoo_tex_hash(addr, params->tLOD[tmu] & 0xf00fff, palette_checksum)];
+    for (; c != -1; c = voodoo->texture_cache[tmu][c].hash_next) {
         if (voodoo->texture_cache[tmu][c].base == addr && voodoo->texture_cache[tmu][c].tLOD == (params->tLOD[tmu] & 0xf00fff) && voodoo->texture_cache[tmu][c].palette_checksum == palette_checksum) {
             params->tex_entry[tmu] = c;
             voodoo->texture_cache[tmu][c].refcount++;
@@ -280,20 +419,23 @@ voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
 
     /*Texture not found, search for unused texture*/
     do {
-        for (c = 0; c < TEX_CACHE_MAX; c++) {
+        for (c = 0; c < voodoo->texture_cache_size; c++) {
             voodoo->texture_last_removed++;
-            voodoo->texture_last_removed &= (TEX_CACHE_MAX - 1);
-            if (voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount == voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount_r[0] && (voodoo->render_threads == 1 || voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount == voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount_r[1]))
+            voodoo->texture_last_removed &= (voodoo->texture_cache_size - 1);
+            if (!voodoo_texture_in_use(voodoo, tmu, voodoo->texture_last_removed))
                 break;
         }
-        if (c == TEX_CACHE_MAX)
+        if (c == voodoo->texture_cache_size)
             voodoo_wait_for_render_thread_idle(voodoo);
-    } while (c == TEX_CACHE_MAX);
-    if (c == TEX_CACHE_MAX)
-        fatal("Texture cache full!\n");
+    } while (c == voodoo->texture_cache_size);
 
     c = voodoo->texture_last_removed;
 
+    if (voodoo->texture_cache[tmu][c].base != -1)
+        voodoo_tex_unlink(voodoo, tmu, c);
+    if (voodoo->texture_cache[tmu][c].data == NULL)
+        voodoo->texture_cache[tmu][c].data = malloc(TEX_ENTRY_SIZE);
+
     if ((voodoo->params.tLOD[tmu] & LOD_SPLIT) && (voodoo->params.tLOD[tmu] & LOD_ODD) && (voodoo->params.tLOD[tmu] & LOD_TMULTIBASEADDR))
         voodoo->texture_cache[tmu][c].base = params->texBaseAddr1[tmu];
     else
@@ -534,58 +676,38 @@ voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
     } else
         voodoo->texture_cache[tmu][c].addr_start[3] = voodoo->texture_cache[tmu][c].addr_end[3] = 0;
 
-    for (uint8_t d = 0; d < 4; d++) {
-        addr     = voodoo->texture_cache[tmu][c].addr_start[d];
-        addr_end = voodoo->texture_cache[tmu][c].addr_end[d];
-
-        if (addr_end != 0) {
-            for (; addr <= addr_end; addr += (1 << TEX_DIRTY_SHIFT))
-                voodoo->texture_present[tmu][(addr & voodoo->texture_mask) >> TEX_DIRTY_SHIFT] = 1;
-        }
-    }
+    voodoo_tex_link(voodoo, tmu, c);
 
     params->tex_entry[tmu] = c;
     voodoo->texture_cache[tmu][c].refcount++;
 }
 
+/*Evicts every cache entry decoded from the page holding dirty_addr, found
+  through the per page reverse index.*/
 void
 flush_texture_cache(voodoo_t *voodoo, uint32_t dirty_addr, int tmu)
 {
-    int wait_for_idle = 0;
+    int       words         = voodoo->texture_cache_size >> 6;
+    uint64_t *users         = &voodoo->texture_users[tmu][(dirty_addr >> TEX_DIRTY_SHIFT) * words];
+    int       wait_for_idle = 0;
 
-    memset(voodoo->texture_present[tmu], 0, sizeof(voodoo->texture_present[0]));
-#if 0
-    voodoo_texture_log("Evict %08x %i\n", dirty_addr, sizeof(voodoo->texture_present));
-#endif
-    for (uint8_t c = 0; c < TEX_CACHE_MAX; c++) {
-        if (voodoo->texture_cache[tmu][c].base != -1) {
-            for (uint8_t d = 0; d < 4; d++) {
-                int addr_start = voodoo->texture_cache[tmu][c].addr_start[d];
-                int addr_end   = voodoo->texture_cache[tmu][c].addr_end[d];
-
-                if (addr_end != 0) {
-                    int addr_start_masked = addr_start & voodoo->texture_mask & ~0x3ff;
-                    int addr_end_masked   = ((addr_end & voodoo->texture_mask) + 0x3ff) & ~0x3ff;
-
-                    if (addr_end_masked < addr_start_masked)
-                        addr_end_masked = voodoo->texture_mask + 1;
-                    if (dirty_addr >= addr_start_masked && dirty_addr < addr_end_masked) {
+    for (int w = 0; w < words; w++) {
+        uint64_t mask = users[w];
+
+        while (mask) {
+            int c = (w << 6) + __builtin_ctzll(mask);
+
+            mask &= (mask - 1);
 #if 0
-                        voodoo_texture_log("  Evict texture %i %08x\n", c, voodoo->texture_cache[tmu][c].base);
+            voodoo_texture_log("  Evict texture %i %08x\n", c, voodoo->texture_cache[tmu][c].base);
 #endif
+            if (voodoo_texture_in_use(voodoo, tmu, c))
+                wait_for_idle = 1;
 
-                        if (voodoo->texture_cache[tmu][c].refcount != voodoo->texture_cache[tmu][c].refcount_r[0] || (voodoo->render_threads == 2 && voodoo->texture_cache[tmu][c].refcount != voodoo->texture_cache[tmu][c].refcount_r[1]))
-                            wait_for_idle = 1;
-
-                        voodoo->texture_cache[tmu][c].base = -1;
-                    } else {
-                        for (; addr_start <= addr_end; addr_start += (1 << TEX_DIRTY_SHIFT))
-                            voodoo->texture_present[tmu][(addr_start & voodoo->texture_mask) >> TEX_DIRTY_SHIFT] = 1;
-                    }
-                }
-            }
+            voodoo_tex_unlink(voodoo, tmu, c);
         }
     }
+
     if (wait_for_idle)
         voodoo_wait_for_render_thread_idle(voodoo);
 }
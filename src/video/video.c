@@ -18,8 +18,10 @@
  *          Copyright 2016-2019 Miran Grca.
  */
 #include <stdatomic.h>
+#include <stdbool.h>
 #define PNG_DEBUG 0
 #include <png.h>
+#include <limits.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -38,10 +40,12 @@
 #include <86box/timer.h>
 #include <86box/path.h>
 #include <86box/plat.h>
+#include <86box/pace.h>
 #include <86box/ui.h>
 #include <86box/thread.h>
 #include <86box/video.h>
 #include <86box/vid_svga.h>
+#include <86box/vid_svga_render.h>
 
 #include <minitrace/minitrace.h>
 
@@ -60,7 +64,9 @@ int          frames               = 0;
 int          fullchange           = 0;
 int          video_grayscale      = 0;
 int          video_graytype       = 0;
-int          monitor_index_global = 0;
+/* Per thread, so a render thread keeps drawing to its own monitor while the
+   emulation thread switches monitors around the polls of other cards. */
+__thread int monitor_index_global = 0;
 uint32_t    *video_6to8           = NULL;
 uint32_t    *video_8togs          = NULL;
 uint32_t    *video_8to32          = NULL;
@@ -201,17 +207,63 @@ const uint32_t shade[5][256] = {
     }
 };
 
-typedef struct blit_data_struct {
+/* Frames are triple-buffered: the card draws into target_buffer (the back
+   frame), a finished frame waits in the ready slot, and the blitter reads
+   the front frame. Publishing and taking a frame are a single atomic
+   exchange of the ready slot, so neither side ever waits for the other.
+
+   Cards only redraw what changed, so the frame that becomes the back frame
+   has to catch up with the one just published first. The blit thread does
+   that copy; the card only waits for it in video_wait_for_buffer_monitor()
+   if it gets to the first line of the next frame before the copy is done. */
+#define VIDEO_FRAMES    3
+#define VIDEO_FRAME_NEW 0x100
+
+typedef struct video_frame_t {
+    bitmap_t *bitmap;
+
+    /* Blit region, and the rows that changed since the blitter last took a
+       frame. */
     int x, y, w, h;
-    int busy;
-    int buffer_in_use;
-    int thread_run;
+    int dirty_y1, dirty_y2;
+
+    /* Rows in which this frame lags the newest published one. */
+    int stale_y1, stale_y2;
+} video_frame_t;
+
+typedef struct blit_data_struct {
+    int        x, y, w, h;
+    atomic_int busy;
+    int        thread_run;
     int monitor_index;
 
+    /* Rows reported dirty by the card since the last blit, the rows the
+       current blit covers, and how many clean frames were dropped since. */
+    int dirty_y1, dirty_y2;
+    int dirty_reported;
+    int blit_y1, blit_y2;
+    int clean_frames;
+
+    video_frame_t frames[VIDEO_FRAMES];
+    atomic_int    ready;
+    int           back;
+    int           front;
+    /* Published rows the blitter may not have seen yet. */
+    int           carry_y1, carry_y2;
+    /* Last published frame and a count of publishes, for the recorder. */
+    int           last;
+    uint32_t      published;
+
+    /* Rows the blit thread still has to copy from the frame just published
+       into the new back frame. */
+    atomic_int    catchup_pending;
+    int           catchup_src, catchup_dst;
+    int           catchup_y1, catchup_y2, catchup_len;
+
     thread_t *blit_thread;
     event_t  *wake_blit_thread;
     event_t  *blit_complete;
-    event_t  *buffer_not_in_use;
+    event_t  *catchup_done;
 } blit_data_t;
 
 static uint32_t cga_2_table[16];
@@ -242,119 +294,247 @@ video_setblit(void (*blit)(int, int, int, int, int))
     blit_func = blit;
 }
 
+/* Blit callbacks call this once they are done with the front frame. The
+   blit thread keeps the frame until it takes the next one, so there is
+   nothing to release. */
 void
-video_blit_complete_monitor(int monitor_index)
+video_blit_complete_monitor(UNUSED(int monitor_index))
 {
-    blit_data_t *blit_data_ptr   = monitors[monitor_index].mon_blit_data_ptr;
-    blit_data_ptr->buffer_in_use = 0;
-
-    thread_set_event(blit_data_ptr->buffer_not_in_use);
+    /* Do nothing. */
 }
 
+/* Waits until every frame published so far has been presented. */
 void
 video_wait_for_blit_monitor(int monitor_index)
 {
     blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
 
-    while (blit_data_ptr->busy)
-        thread_wait_event(blit_data_ptr->blit_complete, -1);
-    thread_reset_event(blit_data_ptr->blit_complete);
+    while (atomic_load(&blit_data_ptr->busy) || (atomic_load(&blit_data_ptr->ready) & VIDEO_FRAME_NEW)) {
+        thread_reset_event(blit_data_ptr->blit_complete);
+        if (atomic_load(&blit_data_ptr->busy) || (atomic_load(&blit_data_ptr->ready) & VIDEO_FRAME_NEW))
+            thread_wait_event(blit_data_ptr->blit_complete, -1);
+    }
 }
 
+/* Cards call this before drawing a new frame: the blit thread may still be
+   bringing the back frame up to date. */
 void
 video_wait_for_buffer_monitor(int monitor_index)
 {
     blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
 
-    while (blit_data_ptr->buffer_in_use)
-        thread_wait_event(blit_data_ptr->buffer_not_in_use, -1);
-    thread_reset_event(blit_data_ptr->buffer_not_in_use);
-}
+    if (blit_data_ptr == NULL)
+        return;
 
-static png_structp png_ptr[MONITORS_NUM];
-static png_infop   info_ptr[MONITORS_NUM];
+    while (atomic_load(&blit_data_ptr->catchup_pending))
+        thread_wait_event(blit_data_ptr->catchup_done, -1);
+}
 
-static void
-video_take_screenshot_monitor(const char *fn, uint32_t *buf, int start_x, int start_y, int row_len, int monitor_index)
+/* The frame the blit callback is presenting; valid from the callback until
+   video_blit_complete_monitor(). */
+bitmap_t *
+video_blit_frame_monitor(int monitor_index)
 {
-    png_bytep         *b_rgb         = NULL;
-    FILE              *fp            = NULL;
-    uint32_t           temp          = 0x00000000;
     const blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
 
-    /* create file */
-    fp = plat_fopen(fn, (const char *) "wb");
-    if (!fp) {
-        video_log("[video_take_screenshot] File %s could not be opened for writing", fn);
-        return;
-    }
+    return blit_data_ptr->frames[blit_data_ptr->front].bitmap;
+}
+
+/* The frame the card published last, or NULL if there is none yet. Only
+   valid on the emulation thread, until the card publishes the next one;
+   *seq changes whenever a new frame has been published. */
+bitmap_t *
+video_last_frame_monitor(int monitor_index, int *x, int *y, int *w, int *h, uint32_t *seq)
+{
+    const blit_data_t   *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+    const video_frame_t *frame;
+
+    if ((blit_data_ptr == NULL) || (blit_data_ptr->last < 0))
+        return NULL;
+
+    frame = &blit_data_ptr->frames[blit_data_ptr->last];
+    *x    = frame->x;
+    *y    = frame->y;
+    *w    = frame->w;
+    *h    = frame->h;
+    *seq  = blit_data_ptr->published;
 
-    /* initialize stuff */
-    png_ptr[monitor_index] = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    return frame->bitmap;
+}
+
+/* Raw screenshots are encoded on their own thread; the blit callback only
+   copies the frame and queues it, waiting only when this many screenshots
+   are already pending. */
+#define SCREENSHOT_QUEUE_SIZE 4
+
+typedef struct screenshot_job_t {
+    char      path[1024];
+    uint32_t *pixels;
+    int       w;
+    int       h;
+    int       format; /* SCREENSHOT_FORMAT_*, matching the extension of path */
+} screenshot_job_t;
+
+static screenshot_job_t screenshot_queue[SCREENSHOT_QUEUE_SIZE];
+static int              screenshot_head;
+static int              screenshot_count;
+static volatile int     screenshot_run;
+static mutex_t         *screenshot_mutex;
+static event_t         *screenshot_wake;
+static event_t         *screenshot_space;
+static thread_t        *screenshot_thread;
 
-    if (!png_ptr[monitor_index]) {
+static void
+video_write_screenshot_png(FILE *fp, const screenshot_job_t *job)
+{
+    png_structp png_ptr;
+    png_infop   info_ptr;
+    png_bytep   row;
+
+    png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if (!png_ptr) {
         video_log("[video_take_screenshot] png_create_write_struct failed");
-        fclose(fp);
         return;
     }
 
-    info_ptr[monitor_index] = png_create_info_struct(png_ptr[monitor_index]);
-    if (!info_ptr[monitor_index]) {
+    info_ptr = png_create_info_struct(png_ptr);
+    if (!info_ptr) {
         video_log("[video_take_screenshot] png_create_info_struct failed");
-        fclose(fp);
+        png_destroy_write_struct(&png_ptr, NULL);
         return;
     }
 
-    png_init_io(png_ptr[monitor_index], fp);
+    png_init_io(png_ptr, fp);
 
-    png_set_IHDR(png_ptr[monitor_index], info_ptr[monitor_index], blit_data_ptr->w, blit_data_ptr->h,
+    /* Faster levels skip the row filters too, they rarely pay off there. */
+    if (screenshot_compression >= 0) {
+        png_set_compression_level(png_ptr, (screenshot_compression > 9) ? 9 : screenshot_compression);
+        if (screenshot_compression <= 1)
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+    }
+
+    png_set_IHDR(png_ptr, info_ptr, job->w, job->h,
                  8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
                  PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
-    b_rgb = (png_bytep *) malloc(sizeof(png_bytep) * blit_data_ptr->h);
-    if (b_rgb == NULL) {
+    row = (png_bytep) malloc(job->w * 3);
+    if (row == NULL) {
         video_log("[video_take_screenshot] Unable to Allocate RGB Bitmap Memory");
-        fclose(fp);
+        png_destroy_write_struct(&png_ptr, &info_ptr);
         return;
     }
 
-    for (int y = 0; y < blit_data_ptr->h; ++y) {
-        b_rgb[y] = (png_byte *) malloc(png_get_rowbytes(png_ptr[monitor_index], info_ptr[monitor_index]));
-        for (int x = 0; x < blit_data_ptr->w; ++x) {
-            if (buf == NULL)
-                memset(&(b_rgb[y][x * 3]), 0x00, 3);
-            else {
-                temp                  = buf[((start_y + y) * row_len) + start_x + x];
-                b_rgb[y][x * 3]       = (temp >> 16) & 0xff;
-                b_rgb[y][(x * 3) + 1] = (temp >> 8) & 0xff;
-                b_rgb[y][(x * 3) + 2] = temp & 0xff;
-            }
+    png_write_info(png_ptr, info_ptr);
+
+    for (int y = 0; y < job->h; ++y) {
+        const uint32_t *src = &job->pixels[y * job->w];
+
+        for (int x = 0; x < job->w; ++x) {
+            row[x * 3]       = (src[x] >> 16) & 0xff;
+            row[(x * 3) + 1] = (src[x] >> 8) & 0xff;
+            row[(x * 3) + 2] = src[x] & 0xff;
         }
+        png_write_row(png_ptr, row);
     }
 
-    png_write_info(png_ptr[monitor_index], info_ptr[monitor_index]);
+    png_write_end(png_ptr, NULL);
 
-    png_write_image(png_ptr[monitor_index], b_rgb);
+    free(row);
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+}
 
-    png_write_end(png_ptr[monitor_index], NULL);
+/* Binary PPM: no compression at all, for automated comparisons. */
+static void
+video_write_screenshot_ppm(FILE *fp, const screenshot_job_t *job)
+{
+    uint8_t *row = (uint8_t *) malloc(job->w * 3);
 
-    /* cleanup heap allocation */
-    for (int i = 0; i < blit_data_ptr->h; i++)
-        if (b_rgb[i])
-            free(b_rgb[i]);
+    if (row == NULL) {
+        video_log("[video_take_screenshot] Unable to Allocate RGB Bitmap Memory");
+        return;
+    }
+
+    fprintf(fp, "P6\n%d %d\n255\n", job->w, job->h);
 
-    if (b_rgb)
-        free(b_rgb);
+    for (int y = 0; y < job->h; ++y) {
+        const uint32_t *src = &job->pixels[y * job->w];
 
-    if (fp)
-        fclose(fp);
+        for (int x = 0; x < job->w; ++x) {
+            row[x * 3]       = (src[x] >> 16) & 0xff;
+            row[(x * 3) + 1] = (src[x] >> 8) & 0xff;
+            row[(x * 3) + 2] = src[x] & 0xff;
+        }
+        fwrite(row, 1, job->w * 3, fp);
+    }
+
+    free(row);
+}
+
+static void
+video_take_screenshot(const screenshot_job_t *job)
+{
+    FILE *fp;
+
+    /* create file */
+    fp = plat_fopen(job->path, (const char *) "wb");
+    if (!fp) {
+        video_log("[video_take_screenshot] File %s could not be opened for writing", job->path);
+        return;
+    }
+
+    if (job->format == SCREENSHOT_FORMAT_PPM)
+        video_write_screenshot_ppm(fp, job);
+    else
+        video_write_screenshot_png(fp, job);
+
+    fclose(fp);
+}
+
+static void
+video_screenshot_thread(UNUSED(void *param))
+{
+    screenshot_job_t job;
+
+    for (;;) {
+        thread_wait_event(screenshot_wake, -1);
+        thread_reset_event(screenshot_wake);
+
+        for (;;) {
+            thread_wait_mutex(screenshot_mutex);
+            if (!screenshot_count) {
+                thread_release_mutex(screenshot_mutex);
+                break;
+            }
+            job = screenshot_queue[screenshot_head];
+            thread_release_mutex(screenshot_mutex);
+
+            video_take_screenshot(&job);
+            free(job.pixels);
+
+            thread_wait_mutex(screenshot_mutex);
+            screenshot_head = (screenshot_head + 1) % SCREENSHOT_QUEUE_SIZE;
+            screenshot_count--;
+            thread_release_mutex(screenshot_mutex);
+            thread_set_event(screenshot_space);
+        }
+
+        /* Whatever was queued before closing has been written by now. */
+        if (!screenshot_run)
+            break;
+    }
 }
 
 void
 video_screenshot_monitor(uint32_t *buf, int start_x, int start_y, int row_len, int monitor_index)
 {
-    char path[1024];
-    char fn[256];
+    const blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+    screenshot_job_t  *job;
+    uint32_t          *pixels;
+    char               path[1024];
+    char               fn[256];
+    const int          w      = blit_data_ptr->w;
+    const int          h      = blit_data_ptr->h;
+    const int          format = screenshot_format;
 
     memset(fn, 0, sizeof(fn));
     memset(path, 0, sizeof(path));
@@ -368,13 +548,39 @@ video_screenshot_monitor(uint32_t *buf, int start_x, int start_y, int row_len, i
     strcat(path, "Monitor_");
     snprintf(&path[strlen(path)], 42, "%d_", monitor_index + 1);
 
-    plat_tempfile(fn, NULL, ".png");
+    plat_tempfile(fn, NULL, (format == SCREENSHOT_FORMAT_PPM) ? ".ppm" : ".png");
     strcat(path, fn);
 
     video_log("taking screenshot to: %s\n", path);
 
-    video_take_screenshot_monitor((const char *) path, buf, start_x, start_y, row_len, monitor_index);
-    png_destroy_write_struct(&png_ptr[monitor_index], &info_ptr[monitor_index]);
+    pixels = (uint32_t *) calloc((size_t) w * h, sizeof(uint32_t));
+    if ((pixels != NULL) && (buf != NULL)) {
+        for (int y = 0; y < h; ++y)
+            memcpy(&pixels[y * w], &buf[((start_y + y) * row_len) + start_x], w * sizeof(uint32_t));
+    }
+
+    if ((pixels != NULL) && (screenshot_thread != NULL)) {
+        thread_wait_mutex(screenshot_mutex);
+        while (screenshot_count == SCREENSHOT_QUEUE_SIZE) {
+            thread_reset_event(screenshot_space);
+            thread_release_mutex(screenshot_mutex);
+            thread_wait_event(screenshot_space, -1);
+            thread_wait_mutex(screenshot_mutex);
+        }
+
+        job = &screenshot_queue[(screenshot_head + screenshot_count) % SCREENSHOT_QUEUE_SIZE];
+        strncpy(job->path, path, sizeof(job->path) - 1);
+        job->path[sizeof(job->path) - 1] = 0;
+        job->pixels                      = pixels;
+        job->w                           = w;
+        job->h                           = h;
+        job->format                      = format;
+        screenshot_count++;
+        thread_release_mutex(screenshot_mutex);
+
+        thread_set_event(screenshot_wake);
+    } else
+        free(pixels);
 
     atomic_fetch_sub(&monitors[monitor_index].mon_screenshots_raw, 1);
 }
@@ -408,47 +614,285 @@ video_transform_copy(void *__restrict _Dst, const void *__restrict _Src, size_t
     return _Dst;
 }
 
+extern bool fast_forward;
+
+/* Above real time, present at most one frame per this many milliseconds. */
+#define VIDEO_TURBO_FRAME_MS 16
+
+static uint32_t blit_last_ticks[MONITORS_NUM];
+
+/* Adaptive frame skip: at most this many frames are skipped in a row. */
+#define VIDEO_FRAMESKIP_MAX 4
+
+static int frameskip_level[MONITORS_NUM];
+static int frameskip_count[MONITORS_NUM];
+
+/* Hands the back frame to the blitter and moves the card on to another
+   frame, leaving the blit thread to bring it up to date with the one just
+   published. Runs on the emulation thread. */
+static void
+video_frame_publish(blit_data_t *data, int x, int y, int w, int h, int y1, int y2)
+{
+    video_frame_t *frame = &data->frames[data->back];
+    video_frame_t *next;
+    int            old;
+
+    /* A card that did not wait before drawing still must not hand over the
+       frame the blit thread is copying into. */
+    video_wait_for_buffer_monitor(data->monitor_index);
+
+    frame->x        = x;
+    frame->y        = y;
+    frame->w        = w;
+    frame->h        = h;
+    frame->dirty_y1 = (y1 < data->carry_y1) ? y1 : data->carry_y1;
+    frame->dirty_y2 = (y2 > data->carry_y2) ? y2 : data->carry_y2;
+    frame->stale_y1 = INT_MAX;
+    frame->stale_y2 = 0;
+
+    for (int i = 0; i < VIDEO_FRAMES; i++) {
+        if (i == data->back)
+            continue;
+        if (y1 < data->frames[i].stale_y1)
+            data->frames[i].stale_y1 = y1;
+        if (y2 > data->frames[i].stale_y2)
+            data->frames[i].stale_y2 = y2;
+    }
+
+    old = atomic_exchange(&data->ready, data->back | VIDEO_FRAME_NEW);
+
+    /* If the previous frame was never taken, its rows travel on with this
+       one; otherwise the blitter has seen everything up to it. */
+    if (old & VIDEO_FRAME_NEW) {
+        data->carry_y1 = frame->dirty_y1;
+        data->carry_y2 = frame->dirty_y2;
+    } else {
+        data->carry_y1 = y1;
+        data->carry_y2 = y2;
+    }
+
+    next = &data->frames[old & 0xff];
+    if (next->stale_y1 < next->stale_y2) {
+        data->catchup_src = data->back;
+        data->catchup_dst = old & 0xff;
+        data->catchup_y1  = (next->stale_y1 > 0) ? next->stale_y1 : 0;
+        data->catchup_y2  = (next->stale_y2 < 2048) ? next->stale_y2 : 2048;
+        data->catchup_len = (x + w) << 2;
+        thread_reset_event(data->catchup_done);
+        atomic_store(&data->catchup_pending, 1);
+    }
+    next->stale_y1 = INT_MAX;
+    next->stale_y2 = 0;
+
+    data->last                                  = data->back;
+    data->published++;
+    data->back                                  = old & 0xff;
+    monitors[data->monitor_index].target_buffer = next->bitmap;
+}
+
+/* Copies the rows the card's new back frame lags behind in. Runs on the
+   blit thread, ahead of presenting anything. */
+static void
+video_frame_catchup(blit_data_t *data)
+{
+    const bitmap_t *src;
+    bitmap_t       *dst;
+
+    if (!atomic_load(&data->catchup_pending))
+        return;
+
+    src = data->frames[data->catchup_src].bitmap;
+    dst = data->frames[data->catchup_dst].bitmap;
+    for (int row = data->catchup_y1; row < data->catchup_y2; row++)
+        memcpy(dst->line[row], src->line[row], data->catchup_len);
+
+    atomic_store(&data->catchup_pending, 0);
+    thread_set_event(data->catchup_done);
+}
+
+/* Takes the newest published frame, if there is one the blitter has not
+   presented yet. Runs on the blit thread. */
+static int
+video_frame_acquire(blit_data_t *data)
+{
+    const video_frame_t *frame;
+
+    if (!(atomic_load(&data->ready) & VIDEO_FRAME_NEW))
+        return 0;
+
+    data->front = atomic_exchange(&data->ready, data->front) & 0xff;
+
+    frame         = &data->frames[data->front];
+    data->x       = frame->x;
+    data->y       = frame->y;
+    data->w       = frame->w;
+    data->h       = frame->h;
+    data->blit_y1 = frame->dirty_y1;
+    data->blit_y2 = frame->dirty_y2;
+
+    return 1;
+}
+
 static void
 blit_thread(void *param)
 {
     blit_data_t *data = param;
+
+    pc_thread_setup(THREAD_ROLE_BLIT);
     while (data->thread_run) {
         thread_wait_event(data->wake_blit_thread, -1);
         thread_reset_event(data->wake_blit_thread);
+
+        video_frame_catchup(data);
+
+        /* Busy before the ready slot empties, so video_wait_for_blit_monitor()
+           never sees neither. */
+        atomic_store(&data->busy, 1);
+        if (!video_frame_acquire(data)) {
+            atomic_store(&data->busy, 0);
+            thread_set_event(data->blit_complete);
+            continue;
+        }
+
         MTR_BEGIN("video", "blit_thread");
 
         if (blit_func)
             blit_func(data->x, data->y, data->w, data->h, data->monitor_index);
 
-        data->busy = 0;
+        atomic_store(&data->busy, 0);
 
         MTR_END("video", "blit_thread");
         thread_set_event(data->blit_complete);
     }
 }
 
+/* Present the unchanged frame again at least this often, so the host side
+   never goes stale for long even if a card underreports what it drew. */
+#define VIDEO_CLEAN_FRAMES_MAX 30
+
+/* Called by cards that track what they draw, before blitting a frame:
+   rows y1 to y2 - 1 of the target buffer changed. An empty range means the
+   frame is the same as the last one. Cards that never call this get every
+   frame treated as fully dirty. */
+void
+video_blit_set_dirty_monitor(int y1, int y2, int monitor_index)
+{
+    blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+
+    if (!blit_data_ptr->dirty_reported) {
+        blit_data_ptr->dirty_y1       = INT_MAX;
+        blit_data_ptr->dirty_y2       = 0;
+        blit_data_ptr->dirty_reported = 1;
+    }
+
+    if (y1 >= y2)
+        return;
+
+    if (y1 < blit_data_ptr->dirty_y1)
+        blit_data_ptr->dirty_y1 = y1;
+    if (y2 > blit_data_ptr->dirty_y2)
+        blit_data_ptr->dirty_y2 = y2;
+}
+
+/* Rows of the target buffer the blit in progress covers; valid from the
+   blit callback until video_blit_complete_monitor(). */
+void
+video_blit_dirty_monitor(int monitor_index, int *y1, int *y2)
+{
+    const blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+
+    *y1 = blit_data_ptr->blit_y1;
+    *y2 = blit_data_ptr->blit_y2;
+}
+
+static int
+video_screenshot_pending(int monitor_index)
+{
+    return atomic_load(&monitors[monitor_index].mon_screenshots) ||
+           atomic_load(&monitors[monitor_index].mon_screenshots_clipboard) ||
+           atomic_load(&monitors[monitor_index].mon_screenshots_raw) ||
+           atomic_load(&monitors[monitor_index].mon_screenshots_raw_clipboard);
+}
+
 void
 video_blit_memtoscreen_monitor(int x, int y, int w, int h, int monitor_index)
 {
+    blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+    int          y1            = y;
+    int          y2            = y + h;
+
     MTR_BEGIN("video", "video_blit_memtoscreen");
 
     if ((w <= 0) || (h <= 0))
         return;
 
-    video_wait_for_blit_monitor(monitor_index);
+    if (blit_data_ptr->dirty_reported) {
+        if (blit_data_ptr->dirty_y1 > y1)
+            y1 = blit_data_ptr->dirty_y1;
+        if (blit_data_ptr->dirty_y2 < y2)
+            y2 = blit_data_ptr->dirty_y2;
+
+        /* Nothing changed: the host already shows this frame. */
+        if ((y1 >= y2) && !video_screenshot_pending(monitor_index) &&
+            !video_force_resize_get_monitor(monitor_index) &&
+            (++blit_data_ptr->clean_frames < VIDEO_CLEAN_FRAMES_MAX)) {
+            blit_data_ptr->dirty_reported = 0;
+            monitors[monitor_index].mon_renderedframes++;
+            return;
+        }
+    }
+
+    /* Running faster than real time, drop the frames the host could not
+       show anyway instead of handing each of them to the blitter. */
+    if ((speed_mult > 1) || fast_forward) {
+        uint32_t ticks = plat_get_ticks();
 
-    monitors[monitor_index].mon_blit_data_ptr->busy          = 1;
-    monitors[monitor_index].mon_blit_data_ptr->buffer_in_use = 1;
-    monitors[monitor_index].mon_blit_data_ptr->x             = x;
-    monitors[monitor_index].mon_blit_data_ptr->y             = y;
-    monitors[monitor_index].mon_blit_data_ptr->w             = w;
-    monitors[monitor_index].mon_blit_data_ptr->h             = h;
+        if ((ticks - blit_last_ticks[monitor_index]) < VIDEO_TURBO_FRAME_MS)
+            return;
+        blit_last_ticks[monitor_index] = ticks;
+    }
+
+    if (y1 >= y2) {
+        y1 = y;
+        y2 = y + h;
+    }
+    blit_data_ptr->dirty_reported = 0;
+    blit_data_ptr->clean_frames   = 0;
+
+    video_frame_publish(blit_data_ptr, x, y, w, h, y1, y2);
     monitors[monitor_index].mon_renderedframes++;
 
-    thread_set_event(monitors[monitor_index].mon_blit_data_ptr->wake_blit_thread);
+    thread_set_event(blit_data_ptr->wake_blit_thread);
     MTR_END("video", "video_blit_memtoscreen");
 }
 
+/* Called once per emulated frame; returns whether the card should skip
+   drawing and presenting it. The number of frames skipped in a row rises
+   while the emulation thread runs behind and falls again once it keeps
+   up. Emulated timing is unaffected, only the drawing is dropped. */
+int
+video_skip_frame(int monitor_index)
+{
+    if (!video_frameskip) {
+        frameskip_level[monitor_index] = frameskip_count[monitor_index] = 0;
+        return 0;
+    }
+
+    if (pace_behind()) {
+        if (frameskip_level[monitor_index] < VIDEO_FRAMESKIP_MAX)
+            frameskip_level[monitor_index]++;
+    } else if (frameskip_level[monitor_index] > 0)
+        frameskip_level[monitor_index]--;
+
+    if (frameskip_count[monitor_index] >= frameskip_level[monitor_index]) {
+        frameskip_count[monitor_index] = 0;
+        return 0;
+    }
+
+    frameskip_count[monitor_index]++;
+    return 1;
+}
+
 uint8_t
 pixels8(uint32_t *pixels)
 {
@@ -762,6 +1206,32 @@ hline(bitmap_t *b, int x1, int y, int x2, uint32_t col)
         b->line[y][x] = col;
 }
 
+void
+glyph_cache_set_palette(glyph_cache_t *gc, const uint32_t *pal)
+{
+    if (!memcmp(gc->pal, pal, sizeof(gc->pal)))
+        return;
+
+    memcpy(gc->pal, pal, sizeof(gc->pal));
+    memset(gc->valid, 0, sizeof(gc->valid));
+}
+
+void
+glyph_cache_build(glyph_cache_t *gc, int pair)
+{
+    const uint32_t fg  = gc->pal[pair >> 4];
+    const uint32_t bg  = gc->pal[pair & 15];
+    uint32_t      *row = gc->rows[pair];
+
+    for (int dat = 0; dat < 256; dat++) {
+        for (int x = 0; x < 8; x++)
+            row[x] = (dat & (0x80 >> x)) ? fg : bg;
+        row += 8;
+    }
+
+    gc->valid[pair >> 5] |= 1u << (pair & 31);
+}
+
 void
 destroy_bitmap(bitmap_t *b)
 {
@@ -801,11 +1271,22 @@ video_monitor_init(int index)
     monitors[index].mon_unscaled_size_y                  = 480;
     monitors[index].mon_bpp                              = 8;
     monitors[index].mon_changeframecount                 = 2;
-    monitors[index].target_buffer                        = create_bitmap(2048, 2048);
     monitors[index].mon_blit_data_ptr                    = calloc(1, sizeof(blit_data_t));
+    for (int i = 0; i < VIDEO_FRAMES; i++) {
+        monitors[index].mon_blit_data_ptr->frames[i].bitmap   = create_bitmap(2048, 2048);
+        monitors[index].mon_blit_data_ptr->frames[i].stale_y1 = INT_MAX;
+    }
+    monitors[index].mon_blit_data_ptr->back              = 0;
+    monitors[index].mon_blit_data_ptr->front             = 1;
+    monitors[index].mon_blit_data_ptr->carry_y1          = INT_MAX;
+    monitors[index].mon_blit_data_ptr->last              = -1;
+    atomic_init(&monitors[index].mon_blit_data_ptr->ready, 2);
+    atomic_init(&monitors[index].mon_blit_data_ptr->busy, 0);
+    atomic_init(&monitors[index].mon_blit_data_ptr->catchup_pending, 0);
+    monitors[index].target_buffer                        = monitors[index].mon_blit_data_ptr->frames[0].bitmap;
     monitors[index].mon_blit_data_ptr->wake_blit_thread  = thread_create_event();
     monitors[index].mon_blit_data_ptr->blit_complete     = thread_create_event();
-    monitors[index].mon_blit_data_ptr->buffer_not_in_use = thread_create_event();
+    monitors[index].mon_blit_data_ptr->catchup_done      = thread_create_event();
     monitors[index].mon_blit_data_ptr->thread_run        = 1;
     monitors[index].mon_blit_data_ptr->monitor_index     = index;
     monitors[index].mon_pal_lookup                       = calloc(sizeof(uint32_t), 256);
@@ -831,17 +1312,19 @@ video_monitor_close(int monitor_index)
     monitors[monitor_index].mon_blit_data_ptr->thread_run = 0;
     thread_set_event(monitors[monitor_index].mon_blit_data_ptr->wake_blit_thread);
     thread_wait(monitors[monitor_index].mon_blit_data_ptr->blit_thread);
+    video_frame_catchup(monitors[monitor_index].mon_blit_data_ptr);
     if (monitor_index >= 1)
         ui_deinit_monitor(monitor_index);
-    thread_destroy_event(monitors[monitor_index].mon_blit_data_ptr->buffer_not_in_use);
+    thread_destroy_event(monitors[monitor_index].mon_blit_data_ptr->catchup_done);
     thread_destroy_event(monitors[monitor_index].mon_blit_data_ptr->blit_complete);
     thread_destroy_event(monitors[monitor_index].mon_blit_data_ptr->wake_blit_thread);
+    for (int i = 0; i < VIDEO_FRAMES; i++)
+        destroy_bitmap(monitors[monitor_index].mon_blit_data_ptr->frames[i].bitmap);
     free(monitors[monitor_index].mon_blit_data_ptr);
     if (!monitors[monitor_index].mon_pal_lookup_static)
         free(monitors[monitor_index].mon_pal_lookup);
     if (!monitors[monitor_index].mon_cga_palette_static)
         free(monitors[monitor_index].mon_cga_palette);
-    destroy_bitmap(monitors[monitor_index].target_buffer);
     monitors[monitor_index].target_buffer = NULL;
     memset(&monitors[monitor_index], 0, sizeof(monitor_t));
 }
@@ -914,6 +1397,16 @@ video_init(void)
     for (uint32_t c = 0; c < 65536; c++)
         video_16to32[c] = calc_16to32(c);
 
+    svga_render_simd_init();
+
+    if (screenshot_thread == NULL) {
+        screenshot_mutex  = thread_create_mutex();
+        screenshot_wake   = thread_create_event();
+        screenshot_space  = thread_create_event();
+        screenshot_run    = 1;
+        screenshot_thread = thread_create(video_screenshot_thread, NULL);
+    }
+
     memset(monitors, 0, sizeof(monitors));
     video_monitor_init(0);
 }
@@ -921,6 +1414,17 @@ video_init(void)
 void
 video_close(void)
 {
+    if (screenshot_thread != NULL) {
+        screenshot_run = 0;
+        thread_set_event(screenshot_wake);
+        thread_wait(screenshot_thread);
+        screenshot_thread = NULL;
+
+        thread_destroy_event(screenshot_space);
+        thread_destroy_event(screenshot_wake);
+        thread_close_mutex(screenshot_mutex);
+    }
+
     video_monitor_close(0);
 
     free(video_16to32);
@@ -27,6 +27,7 @@
 #include <86box/keyboard.h>
 #include <86box/mouse.h>
 #include <86box/plat.h>
+#include <86box/thread.h>
 #include <86box/ui.h>
 #include <86box/vnc.h>
 
@@ -35,6 +36,11 @@
 #define VNC_MIN_Y 200
 #define VNC_MAX_Y 2048
 
+/* Changed areas are reported to the clients per band of this many rows. */
+#define VNC_BAND_Y 16
+/* Rows are compared in chunks of this many pixels. */
+#define VNC_CHUNK_X 32
+
 static rfbScreenInfoPtr rfb = NULL;
 static int              clients;
 static int              updatingSize;
@@ -44,6 +50,24 @@ static int              ptr_x;
 static int              ptr_y;
 static int              ptr_but;
 
+/* The blit callback copies the emulated frame into the shadow buffer and
+   records which rows it touched; the update thread compares those rows
+   with the frame the clients last saw, copies over what changed and marks
+   only that as modified, so the encoders never redo unchanged areas. */
+static uint32_t        *shadow;
+static thread_t        *update_thread;
+static event_t         *update_event;
+static mutex_t         *update_mutex;
+static volatile int     update_run;
+static int              pending_y1;
+static int              pending_y2;
+static int              pending_w;
+static int              pending_full;
+static int              last_x;
+static int              last_y;
+static int              last_w;
+static int              last_h;
+
 #ifdef ENABLE_VNC_LOG
 int vnc_do_log = ENABLE_VNC_LOG;
 
@@ -171,24 +195,158 @@ vnc_display(rfbClientPtr cl)
     }
 }
 
+static void
+vnc_mark_band(int x1, int y1, int x2, int y2)
+{
+    if (x2 > allowedX)
+        x2 = allowedX;
+    if (y2 > allowedY)
+        y2 = allowedY;
+
+    if ((x1 < x2) && (y1 < y2))
+        rfbMarkRectAsModified(rfb, x1, y1, x2, y2);
+}
+
+/* Bring rows y1 to y2 - 1 of the client frame up to date with the shadow
+   buffer, marking the bounding box of the changes in each band. Returns
+   whether changes went unmarked because a resize was in progress. */
+static int
+vnc_update_rows(int y1, int y2, int w)
+{
+    uint32_t *fb       = (uint32_t *) rfb->frameBuffer;
+    int       unmarked = 0;
+
+    for (int band = y1 - (y1 % VNC_BAND_Y); band < y2; band += VNC_BAND_Y) {
+        const int band_end = ((band + VNC_BAND_Y) < y2) ? (band + VNC_BAND_Y) : y2;
+        int       bx1      = w;
+        int       bx2      = 0;
+
+        for (int row = (band > y1) ? band : y1; row < band_end; row++) {
+            const uint32_t *src   = &shadow[row * VNC_MAX_X];
+            uint32_t       *dst   = &fb[row * VNC_MAX_X];
+            int             first = -1;
+            int             last  = 0;
+
+            for (int cx = 0; cx < w; cx += VNC_CHUNK_X) {
+                const int len = ((cx + VNC_CHUNK_X) < w) ? VNC_CHUNK_X : (w - cx);
+
+                if (memcmp(&src[cx], &dst[cx], len * sizeof(uint32_t))) {
+                    if (first < 0)
+                        first = cx;
+                    last = cx + len;
+                }
+            }
+
+            if (first < 0)
+                continue;
+
+            memcpy(&dst[first], &src[first], (last - first) * sizeof(uint32_t));
+            if (first < bx1)
+                bx1 = first;
+            if (last > bx2)
+                bx2 = last;
+        }
+
+        if (bx1 < bx2) {
+            if (updatingSize)
+                unmarked = 1;
+            else
+                vnc_mark_band(bx1, band, bx2, band_end);
+        }
+    }
+
+    return unmarked;
+}
+
+static void
+vnc_update_thread(UNUSED(void *param))
+{
+    int y1;
+    int y2;
+    int w;
+    int full;
+
+    while (update_run) {
+        thread_wait_event(update_event, -1);
+        thread_reset_event(update_event);
+
+        thread_wait_mutex(update_mutex);
+        y1           = pending_y1;
+        y2           = pending_y2;
+        w            = pending_w;
+        full         = pending_full && !updatingSize;
+        pending_y1   = VNC_MAX_Y;
+        pending_y2   = 0;
+        if (full)
+            pending_full = 0;
+        thread_release_mutex(update_mutex);
+
+        if (rfb == NULL)
+            continue;
+
+        if ((y1 < y2) && vnc_update_rows(y1, y2, w)) {
+            thread_wait_mutex(update_mutex);
+            pending_full = 1;
+            thread_release_mutex(update_mutex);
+        }
+
+        /* The clients had a different frame size, send them everything. */
+        if (full)
+            vnc_mark_band(0, 0, allowedX, allowedY);
+    }
+}
+
 static void
 vnc_blit(int x, int y, int w, int h, int monitor_index)
 {
+    const bitmap_t *frame;
+    int             y1;
+    int             y2;
+
     if (monitor_index || (x < 0) || (y < 0) || (w < VNC_MIN_X) || (h < VNC_MIN_Y) || (w > VNC_MAX_X) || (h > VNC_MAX_Y) || (buffer32 == NULL)) {
         video_blit_complete_monitor(monitor_index);
         return;
     }
 
-    for (int row = 0; row < h; ++row)
-        video_copy(&(((uint8_t *) rfb->frameBuffer)[row * 2048 * sizeof(uint32_t)]), &(buffer32->line[y + row][x]), w * sizeof(uint32_t));
+    /* Copy only the rows the card drew, unless the frame moved. */
+    if ((x != last_x) || (y != last_y) || (w != last_w) || (h != last_h)) {
+        y1     = y;
+        y2     = y + h;
+        last_x = x;
+        last_y = y;
+        last_w = w;
+        last_h = h;
+    } else {
+        video_blit_dirty_monitor(monitor_index, &y1, &y2);
+        if (y1 < y)
+            y1 = y;
+        if (y2 > (y + h))
+            y2 = y + h;
+    }
+
+    frame = video_blit_frame_monitor(monitor_index);
+    for (int row = y1; row < y2; ++row)
+        video_copy(&shadow[(row - y) * VNC_MAX_X], &(frame->line[row][x]), w * sizeof(uint32_t));
 
     if (screenshots)
-        video_screenshot((uint32_t *) rfb->frameBuffer, 0, 0, VNC_MAX_X);
+        video_screenshot(shadow, 0, 0, VNC_MAX_X);
 
     video_blit_complete_monitor(monitor_index);
 
-    if (!updatingSize)
-        rfbMarkRectAsModified(rfb, 0, 0, allowedX, allowedY);
+    if (y1 >= y2)
+        return;
+
+    thread_wait_mutex(update_mutex);
+    if ((y1 - y) < pending_y1)
+        pending_y1 = y1 - y;
+    if ((y2 - y) > pending_y2)
+        pending_y2 = y2 - y;
+    pending_w = w;
+    if (updatingSize)
+        pending_full = 1;
+    thread_release_mutex(update_mutex);
+
+    thread_set_event(update_event);
 }
 
 /* Initialize VNC for operation. */
@@ -220,7 +378,8 @@ vnc_init(UNUSED(void *arg))
 
         rfb              = rfbGetScreen(0, NULL, VNC_MAX_X, VNC_MAX_Y, 8, 3, 4);
         rfb->desktopName = title;
-        rfb->frameBuffer = (char *) malloc(VNC_MAX_X * VNC_MAX_Y * 4);
+        rfb->frameBuffer = (char *) calloc(VNC_MAX_X * VNC_MAX_Y, 4);
+        shadow           = (uint32_t *) calloc(VNC_MAX_X * VNC_MAX_Y, 4);
 
         rfb->serverFormat  = rpf;
         rfb->alwaysShared  = TRUE;
@@ -236,6 +395,16 @@ vnc_init(UNUSED(void *arg))
         rfbInitServer(rfb);
 
         rfbRunEventLoop(rfb, -1, TRUE);
+
+        pending_y1   = VNC_MAX_Y;
+        pending_y2   = 0;
+        pending_full = 0;
+        last_w       = 0;
+
+        update_mutex  = thread_create_mutex();
+        update_event  = thread_create_event();
+        update_run    = 1;
+        update_thread = thread_create(vnc_update_thread, NULL);
     }
 
     /* Set up our BLIT handlers. */
@@ -253,8 +422,20 @@ vnc_close(void)
 {
     video_setblit(NULL);
 
+    if (update_thread != NULL) {
+        update_run = 0;
+        thread_set_event(update_event);
+        thread_wait(update_thread);
+        update_thread = NULL;
+
+        thread_destroy_event(update_event);
+        thread_close_mutex(update_mutex);
+    }
+
     if (rfb != NULL) {
         free(rfb->frameBuffer);
+        free(shadow);
+        shadow = NULL;
 
         rfbScreenCleanup(rfb);
 